@@ -0,0 +1,135 @@
+/*
+ *  Description : Thin helpers around the GPIO character device (v2 uAPI).
+ *                A line request fd is used for every value/config access
+ *                so no text formatting or file reopening is needed.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "gpio_cdev.h"
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+namespace bbb
+{
+    namespace cdev
+    {
+        /* Mask covering the first count lines of a request. */
+        static uint64_t all_lines(uint32_t count)
+        {
+            return count >= 64 ? ~0ull : (1ull << count) - 1;
+        }
+
+        /* Fill a line config, adding the output values attribute only for outputs. */
+        static void make_config(gpio_v2_line_config &cfg, uint64_t flags, uint64_t out_values, uint32_t count,
+                                uint32_t debounce_us = 0)
+        {
+            std::memset(&cfg, 0, sizeof(cfg));
+            cfg.flags = flags;
+
+            if (flags & GPIO_V2_LINE_FLAG_OUTPUT)
+            {
+                cfg.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+                cfg.attrs[0].attr.values = out_values;
+                cfg.attrs[0].mask = all_lines(count);
+                cfg.num_attrs = 1;
+            }
+
+            if (debounce_us)
+            {
+                auto &attr = cfg.attrs[cfg.num_attrs++];
+                attr.attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+                attr.attr.debounce_period_us = debounce_us;
+                attr.mask = all_lines(count);
+            }
+        }
+
+        int open_chip(uint16_t chip)
+        {
+            std::string path{chip_path};
+            path += std::to_string(chip);
+
+            int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+            if (fd == -1)
+            {
+                std::cerr << path << " : the chip cannot be opened \n";
+            }
+            return fd;
+        }
+
+        int line_flags(int chip_fd, uint32_t offset, uint64_t &flags)
+        {
+            gpio_v2_line_info info;
+            std::memset(&info, 0, sizeof(info));
+            info.offset = offset;
+
+            if (ioctl(chip_fd, GPIO_V2_GET_LINEINFO_IOCTL, &info) == -1)
+            {
+                std::cerr << "GPIO : Can't get line info\n";
+                return -1;
+            }
+            flags = info.flags;
+
+            return 0;
+        }
+
+        int request_lines(int chip_fd, const uint32_t offsets[], uint32_t count,
+                          uint64_t flags, uint64_t out_values)
+        {
+            if (count == 0 || count > GPIO_V2_LINES_MAX)
+                return -1;
+
+            gpio_v2_line_request req;
+            std::memset(&req, 0, sizeof(req));
+            std::memcpy(req.offsets, offsets, count * sizeof(offsets[0]));
+            std::strncpy(req.consumer, consumer, sizeof(req.consumer) - 1);
+            req.num_lines = count;
+            make_config(req.config, flags, out_values, count);
+
+            if (ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req) == -1)
+            {
+                std::cerr << "GPIO : Can't request lines\n";
+                return -1;
+            }
+
+            return req.fd;
+        }
+
+        int set_config(int line_fd, uint64_t flags, uint64_t out_values, uint32_t count,
+                       uint32_t debounce_us)
+        {
+            gpio_v2_line_config cfg;
+            make_config(cfg, flags, out_values, count, debounce_us);
+
+            if (ioctl(line_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &cfg) == -1)
+            {
+                std::cerr << "GPIO : Can't set line config\n";
+                return -1;
+            }
+            return 0;
+        }
+
+        int set_values(int line_fd, uint64_t mask, uint64_t bits)
+        {
+            gpio_v2_line_values vals{bits, mask};
+
+            return ioctl(line_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &vals);
+        }
+
+        int get_values(int line_fd, uint64_t mask, uint64_t &bits)
+        {
+            gpio_v2_line_values vals{0, mask};
+
+            if (ioctl(line_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &vals) == -1)
+                return -1;
+            bits = vals.bits;
+
+            return 0;
+        }
+    }
+}
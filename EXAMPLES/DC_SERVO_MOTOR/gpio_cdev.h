@@ -0,0 +1,43 @@
+/*
+ *  Description : Thin helpers around the GPIO character device (v2 uAPI).
+ *                A line request fd is used for every value/config access
+ *                so no text formatting or file reopening is needed.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef GPIO_CDEV_H_
+#define GPIO_CDEV_H_
+
+#include <stdint.h>
+#include <linux/gpio.h>
+
+namespace bbb
+{
+    namespace cdev
+    {
+        constexpr static const char chip_path[] = "/dev/gpiochip";
+        constexpr static const char consumer[] = "bbb";
+
+        // AM335x has four banks of 32 lines, gpioN lives on chip N / 32.
+        constexpr static const uint16_t lines_per_chip = 32;
+
+        constexpr uint16_t chip_of(uint16_t number) { return number / lines_per_chip; }
+        constexpr uint32_t offset_of(uint16_t number) { return number % lines_per_chip; }
+
+        int open_chip(uint16_t chip);
+        int line_flags(int chip_fd, uint32_t offset, uint64_t &flags);
+
+        int request_lines(int chip_fd, const uint32_t offsets[], uint32_t count,
+                          uint64_t flags, uint64_t out_values = 0);
+
+        int set_config(int line_fd, uint64_t flags, uint64_t out_values = 0, uint32_t count = 1,
+                       uint32_t debounce_us = 0);
+
+        int set_values(int line_fd, uint64_t mask, uint64_t bits);
+        int get_values(int line_fd, uint64_t mask, uint64_t &bits);
+    }
+}
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ *  Description : Memory-mapped AM335x GPIO bank. Pins are driven with
+ *                plain stores to SETDATAOUT/CLEARDATAOUT, no syscall per
+ *                edge. The register block can be injected from any fd, e.g.
+ *                a memfd standing in for the hardware on a dev machine.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "gpio_mmap.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <mutex>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace bbb
+{
+
+    gpio_bank::gpio_bank(uint16_t bank)
+    {
+        if (bank >= sizeof(am335x::gpio_base) / sizeof(am335x::gpio_base[0]))
+        {
+            throw std::runtime_error{"invalid gpio bank"};
+        }
+
+        int fd = ::open(mem_path, O_RDWR | O_SYNC | O_CLOEXEC);
+        if (fd == -1)
+        {
+            throw std::runtime_error{"/dev/mem cannot be opened"};
+        }
+
+        map(fd, am335x::gpio_base[bank]);
+        ::close(fd); // the mapping stays valid
+    }
+
+    gpio_bank::gpio_bank(int fd, off_t offset)
+    {
+        map(fd, offset);
+    }
+
+    void gpio_bank::map(int fd, off_t offset)
+    {
+        void *addr = mmap(nullptr, am335x::gpio_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+        if (addr == MAP_FAILED)
+        {
+            throw std::runtime_error{"gpio bank registers cannot be mapped"};
+        }
+        m_regs = static_cast<volatile uint32_t *>(addr);
+    }
+
+    /* One mapping per bank is shared by every pin of the process. */
+    std::shared_ptr<gpio_bank> gpio_bank::get(uint16_t bank)
+    {
+        static std::mutex mtx;
+        static std::weak_ptr<gpio_bank> banks[sizeof(am335x::gpio_base) / sizeof(am335x::gpio_base[0])];
+
+        std::lock_guard<std::mutex> lock{mtx};
+        if (bank >= sizeof(banks) / sizeof(banks[0]))
+        {
+            throw std::runtime_error{"invalid gpio bank"};
+        }
+
+        auto ptr = banks[bank].lock();
+        if (!ptr)
+        {
+            ptr = std::make_shared<gpio_bank>(bank);
+            banks[bank] = ptr;
+        }
+        return ptr;
+    }
+
+    std::shared_ptr<fake_gpio_bank> gpio_bank::fake()
+    {
+        return std::make_shared<fake_gpio_bank>();
+    }
+
+    static int fake_fd()
+    {
+        int fd = memfd_create("am335x_gpio", MFD_CLOEXEC);
+        if (fd == -1 || ftruncate(fd, am335x::gpio_size) == -1)
+        {
+            throw std::runtime_error{"fake gpio bank cannot be created"};
+        }
+        return fd;
+    }
+
+    fake_gpio_bank::fake_gpio_bank() : fake_gpio_bank{fake_fd()}
+    {
+    }
+
+    fake_gpio_bank::fake_gpio_bank(int fd) : gpio_bank{fd, 0}
+    {
+        ::close(fd);
+        reg(am335x::gpio_oe) = ~0u; // reset value, all inputs
+    }
+
+    /*
+        The SET/CLEARDATAOUT bits written are moved into DATAOUT and the
+        registers read back as 0. DATAIN follows DATAOUT on the output pins,
+        the input pins keep their level.
+    */
+    void fake_gpio_bank::latch()
+    {
+        uint32_t out = reg(am335x::gpio_dataout);
+        out |= reg(am335x::gpio_setdataout);
+        out &= ~reg(am335x::gpio_cleardataout);
+
+        reg(am335x::gpio_setdataout) = 0;
+        reg(am335x::gpio_cleardataout) = 0;
+        reg(am335x::gpio_dataout) = out;
+
+        uint32_t oe = reg(am335x::gpio_oe);
+        uint32_t in = reg(am335x::gpio_datain);
+        reg(am335x::gpio_datain) = (in & oe) | (out & ~oe);
+    }
+
+    gpio_bank::~gpio_bank()
+    {
+        if (m_regs)
+            munmap(const_cast<uint32_t *>(m_regs), am335x::gpio_size);
+    }
+}
@@ -1,128 +1,178 @@
 /*
- *  Description : Simple PWM interface. It can be used only beaglebone
- *                black P9_14, P9_16, P9_21 and P9_22 pins for now.
+ *  Description : Simple PWM interface for the beaglebone black ehrpwm and
+ *                ecap outputs listed in pwm_pins.h. The attribute files are
+ *                kept open and the period is cached.
  *  License     : MIT License
  *  Created on  : 2025
  *  Author      : Heval Aktaş
  *  Email       : hevalakts@gmail.com
  */
 #include "pwm.h"
+#include "sysfs_root.h"
+
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace bbb
 {
 
-    pwm::pwm(uint16_t pin)
+    static const pwm_pin_info &p9_pin(uint16_t pin)
     {
-
-        if (14 == pin || pin == 16)
-        {
-            pwm_path += '1';
-            pwm_path += '/';
-            pwm_path += pin == 14 ? 'a' : 'b';
-        }
-        else if (22 == pin || pin == 21)
-        {
-            pwm_path += '0';
-            pwm_path += '/';
-            pwm_path += pin == 22 ? 'a' : 'b';
-        }
-        else
+        auto i = find_pwm_pin(bbb::header::P9, pin);
+        if (pin > UINT8_MAX || i == pwm_pin_count)
         {
             throw std::runtime_error{"invalid pin number for pwm"};
         }
+        return pwm_pins[i];
+    }
+
+    pwm::pwm(uint16_t pin) : pwm{p9_pin(pin)}
+    {
+    }
 
-        std::string file_path{state_path};
-        file_path += std::to_string(pin);
-        file_path += "_pinmux/state";
+    pwm::pwm(const pwm_pin_info &pin) : m_pin{pin}
+    {
+        const auto &root = sysfs_root();
 
-        m_file.open(file_path);
+        m_file.open(root + m_pin.state);
         if (!m_file)
         {
-            std::cerr << "Pin " << pin << " cannot be exported!" << '\n';
+            std::cerr << "Pin P" << static_cast<int>(m_pin.hdr) << '_' << +m_pin.pin << " cannot be exported!" << '\n';
         }
         m_file << "pwm";
         m_file.close();
+
+        std::string path{root + m_pin.path};
+        m_period_fd = open_attr(path, period);
+        m_duty_fd = open_attr(path, duty_cycle);
+        m_enable_fd = open_attr(path, enable);
+        m_polarity_fd = open_attr(path, polarity);
+
+        m_period = atoi(read(m_period_fd, period).c_str());
+    }
+
+    /* The attribute files stay open for the lifetime of the object. */
+    int pwm::open_attr(const std::string &path, const char *filename)
+    {
+        int fd = ::open((path + filename).c_str(), O_RDWR | O_CLOEXEC);
+        if (fd == -1)
+        {
+            std::cerr << "PWM : Can't open " << filename << '\n';
+        }
+        return fd;
     }
 
-    int pwm::write(const char *filename, std::string value)
+    int pwm::write(int fd, const char *filename, uint32_t value)
     {
-        m_file.open(pwm_path + filename);
-        if (!m_file.is_open())
+        char buffer[16];
+        auto res = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+        if (::pwrite(fd, buffer, res.ptr - buffer, 0) == -1)
         {
             std::cerr << "PWM : Can't set " << filename << '\n';
+            return -1;
         }
-        m_file << value;
-        m_file.close();
+        return 0;
+    }
 
+    int pwm::write(int fd, const char *filename, const char *value)
+    {
+        if (::pwrite(fd, value, std::strlen(value), 0) == -1)
+        {
+            std::cerr << "PWM : Can't set " << filename << '\n';
+            return -1;
+        }
         return 0;
     }
 
-    std::string pwm::read(const char *filename)
+    std::string pwm::read(int fd, const char *filename)
     {
-        m_file.open(pwm_path + filename);
-        if (!m_file.is_open())
+        char buffer[32];
+        ssize_t len = ::pread(fd, buffer, sizeof(buffer) - 1, 0);
+        if (len < 0)
         {
             std::cerr << "PWM : Can't get " << filename << '\n';
+            return {};
         }
 
-        std::string info;
-        getline(m_file, info);
-        m_file.close();
+        std::string info{buffer, static_cast<std::size_t>(len)};
+        if (!info.empty() && info.back() == '\n')
+            info.pop_back();
 
         return info;
     }
 
     int pwm::set_period(uint32_t per)
     {
-        return write(period, std::to_string(per));
+        if (write(m_period_fd, period, per) == -1)
+            return -1;
+
+        m_period = per;
+        return 0;
     }
 
     int pwm::get_period()
     {
-        return atoi(read(period).c_str());
+        return m_period;
     }
 
     int pwm::set_duty_cycle(uint32_t duty)
     {
-        return write(duty_cycle, std::to_string(duty));
+        return write(m_duty_fd, duty_cycle, duty);
     }
 
     int pwm::set_duty_cycle(double per)
     {
         if (per < 0 || 100 < per)
             return -1;
-        uint32_t duty = get_period() * (per / 100.);
+        uint32_t duty = m_period * (per / 100.);
 
         return set_duty_cycle(duty);
     }
 
     int pwm::set_enable()
     {
-        return write(enable, "1");
+        return write(m_enable_fd, enable, "1");
     }
 
     int pwm::get_duty_cycle()
     {
-        return atoi(read(duty_cycle).c_str());
+        return atoi(read(m_duty_fd, duty_cycle).c_str());
     }
 
     int pwm::set_disable()
     {
-        return write(enable, "0");
+        return write(m_enable_fd, enable, "0");
+    }
+
+    int pwm::get_enable()
+    {
+        return atoi(read(m_enable_fd, enable).c_str());
     }
 
     int pwm::set_normal_polarity()
     {
-        return write(polarity, pwm::poles::normal);
+        return write(m_polarity_fd, polarity, pwm::poles::normal);
     }
 
     int pwm::set_inversed_polarity()
     {
-        return write(polarity, pwm::poles::inversed);
+        return write(m_polarity_fd, polarity, pwm::poles::inversed);
     }
 
     std::string pwm::get_polarity()
     {
-        return read(polarity);
+        return read(m_polarity_fd, polarity);
+    }
+
+    pwm::~pwm()
+    {
+        for (int fd : {m_period_fd, m_duty_fd, m_enable_fd, m_polarity_fd})
+        {
+            if (fd != -1)
+                ::close(fd);
+        }
     }
 }
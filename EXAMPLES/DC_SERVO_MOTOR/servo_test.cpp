@@ -5,7 +5,7 @@
  *  Author      : Heval Aktaş
  *  Email       : hevalakts@gmail.com
  */
-#include "pwm.h"
+#include "motion.h"
 #include <iostream>
 #include <thread>
 
@@ -28,27 +28,27 @@ int main()
 
     mypwm.set_period(20'000'000u);
     mypwm.set_normal_polarity();
+    mypwm.set_duty_cycle(500'000u);
     mypwm.set_enable();
-    int n{3};
 
+    bbb::motion servos{20'000'000u}; // one update per servo frame
+    auto sg90 = servos.add(mypwm, 500'000u, 2'400'000u, 180.);
+    servos.start();
+
+    int n{3};
     while (n--)
     {
-        int cnt{0};
-        double d_c{2.5};
-
-        while (cnt < 7)
-        {
-            mypwm.set_duty_cycle(d_c);
-            d_c += 1.583333;
-
-            std::cout << " " << cnt++ << "  ";
-            std::cout << "duty_cycle : "
-                      << mypwm.get_duty_cycle()
-                      << '\n';
-            std::this_thread::sleep_for(500ms);
-        }
-        std::cout << '\n';
+        servos.move_to_angle(sg90, 180., 1500ms, bbb::profile::s_curve);
+        servos.wait_idle();
+        std::cout << "duty_cycle : " << mypwm.get_duty_cycle() << '\n';
+
+        servos.move_to_angle(sg90, 0., 1500ms, bbb::profile::trapezoidal);
+        servos.wait_idle();
+        std::cout << "duty_cycle : " << mypwm.get_duty_cycle() << '\n';
     }
 
+    servos.stop();
+    std::cout << "missed deadlines : " << servos.missed_deadlines() << '\n';
+
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,135 @@
+/*
+ *  Description : Asynchronous bus requests. Every bus (i2c-1, i2c-2, spi0
+ *                ...) gets one worker thread that takes all queued requests
+ *                at once and runs them back to back, so devices on
+ *                different buses proceed in parallel while the caller
+ *                keeps running. A request completes through a future and an
+ *                optional callback, can be cancelled until it starts and is
+ *                dropped if its deadline has passed when its turn comes.
+ *                Buffers passed to a request must stay valid until then.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef BUS_WORKER_H_
+#define BUS_WORKER_H_
+
+#include <stdint.h>
+#include <string>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+
+namespace bbb
+{
+    enum class async_status
+    {
+        done,
+        failed,    // the bus call returned an error
+        cancelled,
+        expired    // the deadline passed before the request could start
+    };
+
+    struct async_result
+    {
+        bbb::async_status status;
+        int ret; // return value of the bus call
+        std::chrono::nanoseconds queued; // submit to start
+        std::chrono::nanoseconds run;    // on the bus
+    };
+
+    struct async_options
+    {
+        std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+        std::function<void(const bbb::async_result &)> on_done; // called from the worker, must not destroy the device
+    };
+
+    class async_request
+    {
+        friend class bus_worker;
+
+        enum state : int
+        {
+            queued,
+            running,
+            finished,
+            dropped // its device is gone : no callback, the future gets broken_promise
+        };
+        std::shared_ptr<std::atomic<int>> m_state;
+
+    public:
+        std::future<bbb::async_result> result;
+
+        bool cancel(); // true if the request will not run
+    };
+
+    struct bus_worker_stats
+    {
+        uint64_t done{0};
+        uint64_t failed{0};
+        uint64_t cancelled{0};
+        uint64_t expired{0};
+        uint64_t batches{0};   // wake ups of the worker
+        uint64_t max_batch{0}; // requests taken at once
+        std::chrono::nanoseconds max_queued{0};
+        std::chrono::nanoseconds max_run{0};
+    };
+
+    class bus_worker
+    {
+    public:
+        static std::shared_ptr<bus_worker> get(const std::string &bus); // one worker per bus name
+
+        explicit bus_worker(std::string name);
+        bus_worker(const bus_worker &) = delete;
+        bus_worker &operator=(const bus_worker &) = delete;
+
+        // job returns 0 on success like the bus calls, owner is the device it belongs to
+        bbb::async_request submit(std::function<int()> job, bbb::async_options opts = {}, const void *owner = nullptr);
+
+        void cancel(const void *owner); // drops the queued requests of the owner, waits for its running one
+
+        const std::string &name() const { return m_name; }
+        bbb::bus_worker_stats stats();
+
+        ~bus_worker(); // queued requests are cancelled
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct request
+        {
+            std::function<int()> job;
+            bbb::async_options opts;
+            const void *owner;
+            std::shared_ptr<std::atomic<int>> state;
+            std::promise<bbb::async_result> promise;
+            clock::time_point queued;
+        };
+
+        void run();
+        void finish(request &req, bbb::async_result res);
+
+        std::string m_name;
+
+        std::mutex m_mtx;
+        std::condition_variable m_cv;
+        std::condition_variable m_finished; // a request of m_batch finished
+        std::deque<request> m_queue;
+        std::vector<request> m_batch; // resized by the worker under m_mtx only
+        bool m_stop{false};
+        bbb::bus_worker_stats m_stats;
+
+        std::thread m_thread;
+    };
+}
+
+#endif
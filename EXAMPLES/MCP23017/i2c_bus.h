@@ -0,0 +1,84 @@
+/*
+ *  Description : One I2C adapter shared by every i2c_device on it. The bus
+ *                owns a single fd and addresses devices per message with
+ *                I2C_RDWR, so no I2C_SLAVE state is kept on the fd.
+ *                Transactions from several threads are queued in arrival
+ *                order and run back to back; utilization and queue depth
+ *                are counted per bus.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef I2C_BUS_H_
+#define I2C_BUS_H_
+
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+struct i2c_msg;
+
+namespace bbb
+{
+    struct i2c_bus_stats
+    {
+        uint64_t transactions{0};
+        uint64_t messages{0};
+        uint64_t bytes{0};
+        uint64_t errors{0};
+        uint64_t busy_ns{0};    // inside the adapter
+        uint64_t wait_ns{0};    // queued behind other transactions
+        uint64_t elapsed_ns{0}; // since the bus was opened or the counters cleared
+        uint32_t depth{0};      // transactions queued or running now
+        uint32_t max_depth{0};
+
+        double utilization() const { return elapsed_ns ? double(busy_ns) / elapsed_ns : 0.; }
+    };
+
+    class i2c_bus
+    {
+    public:
+        static std::shared_ptr<i2c_bus> get(uint32_t bus); // shared by everyone using the adapter
+        static void install(uint32_t bus, std::shared_ptr<i2c_bus> replacement); // nullptr removes it
+
+        explicit i2c_bus(uint32_t bus);
+        i2c_bus(const i2c_bus &) = delete;
+        i2c_bus &operator=(const i2c_bus &) = delete;
+
+        int transfer(i2c_msg *msgs, uint32_t count, uint64_t *busy_ns = nullptr); // blocks while queued, one I2C_RDWR
+
+        uint32_t number() const { return m_number; }
+        unsigned long functionality() const { return m_funcs; } // I2C_FUNC_* of the adapter
+
+        bbb::i2c_bus_stats stats();
+        void clear_stats();
+
+        virtual ~i2c_bus();
+
+    protected:
+        i2c_bus(uint32_t bus, unsigned long funcs); // no adapter behind it
+
+        virtual int execute(i2c_msg *msgs, uint32_t count);
+        int fd() const { return m_fd; }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        uint32_t m_number;
+        int m_fd{-1};
+        unsigned long m_funcs{0};
+
+        std::mutex m_mtx;
+        std::condition_variable m_turn;
+        uint64_t m_next{0};    // ticket of the next transaction
+        uint64_t m_serving{0}; // ticket allowed on the bus
+
+        bbb::i2c_bus_stats m_stats;
+        clock::time_point m_since{clock::now()};
+    };
+}
+
+#endif
@@ -0,0 +1,248 @@
+/*
+ *  Description : In-process I2C bus for tests and benchmarks without a
+ *                board. i2c_sim_bus is installed in place of /dev/i2c-N
+ *                with i2c_bus::install, so drivers run unmodified against
+ *                simulated devices : a register map with an optional auto
+ *                increment pointer and read/write callbacks. Transactions
+ *                take the time they would at the configured bus clock.
+ *                i2c_stub_bus runs the same messages on the kernel
+ *                i2c-stub module, which only speaks SMBus.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "i2c_sim.h"
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <dirent.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+namespace bbb
+{
+
+    void i2c_sim_device::write(const uint8_t *buffer, uint16_t length)
+    {
+        if (length == 0)
+            return;
+
+        m_pointer = buffer[0];
+        for (uint16_t i{1}; i < length; i++)
+        {
+            uint8_t reg = m_pointer;
+            regs[reg] = buffer[i];
+            if (on_write)
+                on_write(reg, buffer[i]);
+
+            if (m_auto_increment)
+                m_pointer++;
+        }
+    }
+
+    void i2c_sim_device::read(uint8_t *buffer, uint16_t length)
+    {
+        for (uint16_t i{0}; i < length; i++)
+        {
+            uint8_t val = regs[m_pointer];
+            if (on_read)
+                on_read(m_pointer, val);
+            buffer[i] = val;
+
+            if (m_auto_increment)
+                m_pointer++;
+        }
+    }
+
+    i2c_sim_bus::i2c_sim_bus(uint32_t bus, uint32_t clock_hz) : i2c_bus{bus, I2C_FUNC_I2C}, m_clock_hz{clock_hz}
+    {
+    }
+
+    i2c_sim_device &i2c_sim_bus::attach(uint16_t address, bool auto_increment)
+    {
+        auto &dev = m_devices[address];
+        dev = std::make_unique<i2c_sim_device>(auto_increment);
+        return *dev;
+    }
+
+    /*
+        A message costs a (repeated) start and the address byte, every data
+        byte nine clocks with its ack, and the transaction ends with a stop.
+        A missing device does not ack its address and fails the whole call.
+    */
+    int i2c_sim_bus::execute(i2c_msg *msgs, uint32_t count)
+    {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t bits{1};
+
+        int ret{0};
+        for (uint32_t i{0}; i < count; i++)
+        {
+            bits += 1 + 9;
+
+            auto it = m_devices.find(msgs[i].addr);
+            if (it == m_devices.end())
+            {
+                ret = 1;
+                break;
+            }
+
+            if (msgs[i].flags & I2C_M_RD)
+                it->second->read(msgs[i].buf, msgs[i].len);
+            else
+                it->second->write(msgs[i].buf, msgs[i].len);
+
+            bits += 9 * msgs[i].len;
+        }
+
+        if (m_clock_hz)
+        {
+            auto wire = std::chrono::nanoseconds{bits * 1'000'000'000ull / m_clock_hz};
+            m_bus_ns += wire.count();
+            std::this_thread::sleep_until(start + wire);
+        }
+
+        return ret;
+    }
+
+    /* i2c-stub names its adapter "SMBus stub driver". */
+    int i2c_stub_bus::find()
+    {
+        DIR *dir = opendir("/sys/bus/i2c/devices");
+        if (!dir)
+            return -1;
+
+        int found{-1};
+        while (dirent *ent = readdir(dir))
+        {
+            std::string name{ent->d_name};
+            if (name.rfind("i2c-", 0) != 0)
+                continue;
+
+            std::ifstream file{"/sys/bus/i2c/devices/" + name + "/name"};
+            std::string adapter;
+            if (std::getline(file, adapter) && adapter == "SMBus stub driver")
+            {
+                found = std::stoi(name.substr(4));
+                break;
+            }
+        }
+        closedir(dir);
+
+        return found;
+    }
+
+    i2c_stub_bus::i2c_stub_bus(uint32_t bus) : i2c_bus{bus}
+    {
+    }
+
+    int i2c_stub_bus::select(uint16_t address)
+    {
+        if (m_address == address)
+            return 0;
+
+        if (ioctl(fd(), I2C_SLAVE, address) < 0)
+            return 1;
+
+        m_address = address;
+        return 0;
+    }
+
+    int i2c_stub_bus::smbus(uint8_t rw, uint8_t command, uint32_t size, void *data)
+    {
+        i2c_smbus_ioctl_data args{rw, command, size, static_cast<i2c_smbus_data *>(data)};
+
+        return ioctl(fd(), I2C_SMBUS, &args) < 0 ? 1 : 0;
+    }
+
+    /*
+        I2C_RDWR messages mapped onto SMBus : a register write followed by a
+        read becomes byte or i2c block reads, a register write with data
+        becomes byte or i2c block writes of at most 32 bytes. i2c-stub
+        advances its pointer within a block, so long bursts are split by
+        register. A lone read continues from the current pointer.
+    */
+    int i2c_stub_bus::execute(i2c_msg *msgs, uint32_t count)
+    {
+        for (uint32_t i{0}; i < count; i++)
+        {
+            auto &msg = msgs[i];
+            if (select(msg.addr) != 0)
+                return 1;
+
+            i2c_smbus_data data;
+
+            if (msg.flags & I2C_M_RD)
+            {
+                for (uint16_t n{0}; n < msg.len; n++)
+                {
+                    if (smbus(I2C_SMBUS_READ, 0, I2C_SMBUS_BYTE, &data) != 0)
+                        return 1;
+                    msg.buf[n] = data.byte;
+                }
+                continue;
+            }
+
+            if (msg.len == 0)
+                continue;
+
+            uint8_t reg = msg.buf[0];
+
+            if (msg.len == 1 && i + 1 < count && (msgs[i + 1].flags & I2C_M_RD) && msgs[i + 1].addr == msg.addr)
+            {
+                auto &rd = msgs[++i];
+                for (uint16_t n{0}; n < rd.len;)
+                {
+                    uint8_t chunk = std::min<uint16_t>(rd.len - n, I2C_SMBUS_BLOCK_MAX);
+                    data.block[0] = chunk;
+
+                    int err = chunk == 1 ? smbus(I2C_SMBUS_READ, reg + n, I2C_SMBUS_BYTE_DATA, &data)
+                                         : smbus(I2C_SMBUS_READ, reg + n, I2C_SMBUS_I2C_BLOCK_DATA, &data);
+                    if (err)
+                        return 1;
+
+                    if (chunk == 1)
+                        rd.buf[n] = data.byte;
+                    else
+                        std::copy(data.block + 1, data.block + 1 + chunk, rd.buf + n);
+                    n += chunk;
+                }
+                continue;
+            }
+
+            if (msg.len == 1)
+            {
+                if (smbus(I2C_SMBUS_WRITE, reg, I2C_SMBUS_BYTE, nullptr) != 0)
+                    return 1;
+                continue;
+            }
+
+            for (uint16_t n{1}; n < msg.len;)
+            {
+                uint8_t chunk = std::min<uint16_t>(msg.len - n, I2C_SMBUS_BLOCK_MAX);
+                int err;
+                if (chunk == 1)
+                {
+                    data.byte = msg.buf[n];
+                    err = smbus(I2C_SMBUS_WRITE, reg + n - 1, I2C_SMBUS_BYTE_DATA, &data);
+                }
+                else
+                {
+                    data.block[0] = chunk;
+                    std::copy(msg.buf + n, msg.buf + n + chunk, data.block + 1);
+                    err = smbus(I2C_SMBUS_WRITE, reg + n - 1, I2C_SMBUS_I2C_BLOCK_DATA, &data);
+                }
+                if (err)
+                    return 1;
+                n += chunk;
+            }
+        }
+
+        return 0;
+    }
+}
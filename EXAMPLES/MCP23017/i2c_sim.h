@@ -0,0 +1,83 @@
+/*
+ *  Description : In-process I2C bus for tests and benchmarks without a
+ *                board. i2c_sim_bus is installed in place of /dev/i2c-N
+ *                with i2c_bus::install, so drivers run unmodified against
+ *                simulated devices : a register map with an optional auto
+ *                increment pointer and read/write callbacks. Transactions
+ *                take the time they would at the configured bus clock.
+ *                i2c_stub_bus runs the same messages on the kernel
+ *                i2c-stub module, which only speaks SMBus.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef I2C_SIM_H_
+#define I2C_SIM_H_
+
+#include "i2c_bus.h"
+
+#include <stdint.h>
+#include <map>
+#include <memory>
+#include <functional>
+
+namespace bbb
+{
+
+    class i2c_sim_device
+    {
+    public:
+        explicit i2c_sim_device(bool auto_increment = true) : m_auto_increment{auto_increment} {}
+
+        uint8_t regs[256]{0};
+
+        std::function<void(uint8_t reg, uint8_t val)> on_write;  // after the register is stored
+        std::function<void(uint8_t reg, uint8_t &val)> on_read;  // may change the value returned
+
+        void write(const uint8_t *buffer, uint16_t length); // first byte is the register pointer
+        void read(uint8_t *buffer, uint16_t length);
+
+    private:
+        bool m_auto_increment;
+        uint8_t m_pointer{0};
+    };
+
+    class i2c_sim_bus : public i2c_bus
+    {
+    public:
+        explicit i2c_sim_bus(uint32_t bus, uint32_t clock_hz = 400'000);
+
+        i2c_sim_device &attach(uint16_t address, bool auto_increment = true); // before the bus is used
+
+        void set_clock(uint32_t hz) { m_clock_hz = hz; } // 0 runs without waiting
+        uint64_t bus_ns() const { return m_bus_ns; }     // simulated time on the wire
+
+    protected:
+        int execute(i2c_msg *msgs, uint32_t count) override;
+
+    private:
+        std::map<uint16_t, std::unique_ptr<i2c_sim_device>> m_devices;
+        uint32_t m_clock_hz;
+        uint64_t m_bus_ns{0};
+    };
+
+    class i2c_stub_bus : public i2c_bus
+    {
+    public:
+        static int find(); // adapter number of a loaded i2c-stub, -1 if there is none
+
+        explicit i2c_stub_bus(uint32_t bus);
+
+    protected:
+        int execute(i2c_msg *msgs, uint32_t count) override;
+
+    private:
+        int smbus(uint8_t rw, uint8_t command, uint32_t size, void *data);
+        int select(uint16_t address);
+
+        int m_address{-1}; // I2C_SLAVE of the fd
+    };
+}
+
+#endif
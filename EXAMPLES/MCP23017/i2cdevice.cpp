@@ -7,51 +7,45 @@
 
 #include "i2cdevice.h"
 #include <iostream>
-#include <fcntl.h>
-#include <unistd.h>
-#include <sys/ioctl.h>
-#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <chrono>
 
 namespace bbb
 {
-    /*The constructor opens a file descriptor to the I2C device*/
+    /*The constructor attaches the device to its I2C bus*/
     i2c_device::i2c_device(uint32_t bus, uint32_t devaddr) : bus{bus}, device{devaddr}
     {
         open();
     }
 
-    /*Open a connection to an I2C device.*/
+    /*Attach to the bus, its fd is opened by the first device on it.*/
     int i2c_device::open()
     {
-        const char *device_name = bus == 1 ? bbb_12c_1 : bbb_12c_2;
-
-        if ((fd = ::open(device_name, O_RDWR)) < 0)
+        try
         {
-            std::cerr << "Failed to open I2C device file.\n";
-            return 1;
+            m_bus = i2c_bus::get(bus);
         }
-
-        if (ioctl(fd, I2C_SLAVE, device) < 0)
+        catch (const std::runtime_error &e)
         {
-            std::cerr << "Failed to set I2C slave address.\n";
+            std::cerr << e.what() << '\n';
             return 1;
         }
 
+        nostart = m_bus->functionality() & I2C_FUNC_NOSTART;
+
         return 0;
     }
 
     /* Write a single value to the I2C device.*/
     int i2c_device::write(uint8_t val)
     {
-        uint8_t buffer[1];
-        buffer[0] = val;
+        i2c_msg msg{static_cast<uint16_t>(device), 0, 1, &val};
 
-        if (::write(fd, buffer, 1) != 1)
-        {
-            std::cerr << "failed to write I2C device file.\n";
-            return 1;
-        }
-        return 0;
+        return transfer(&msg, 1);
     }
 
     /* Write a single byte value to a single register.*/
@@ -61,51 +55,175 @@ namespace bbb
         buffer[0] = regaddr;
         buffer[1] = val;
 
-        if (::write(fd, buffer, 2) != 2)
+        i2c_msg msg{static_cast<uint16_t>(device), 0, 2, buffer};
+
+        return transfer(&msg, 1);
+    }
+
+    /* Submit several messages as one transaction of the bus queue, all addressed to this device unless set otherwise.*/
+    int i2c_device::transfer(i2c_msg *msgs, uint32_t count)
+    {
+        if (!m_bus)
         {
-            std::cerr << "failed to write I2C device file.\n";
+            std::cerr << "I2C device is not open.\n";
             return 1;
         }
-        return 0;
+
+        auto type = xfer_type::write;
+        uint64_t in{0}, out{0};
+        for (uint32_t i{0}; i < count; i++)
+        {
+            if (msgs[i].flags & I2C_M_RD)
+            {
+                type = xfer_type::read;
+                in += msgs[i].len;
+            }
+            else
+            {
+                out += msgs[i].len;
+            }
+        }
+
+        int ret{1};
+        for (int attempt{0}; attempt <= m_retries && ret != 0; attempt++)
+        {
+            if (attempt)
+                m_counters.retry();
+
+            auto start = std::chrono::steady_clock::now();
+            uint64_t busy{0};
+            ret = m_bus->transfer(msgs, count, &busy);
+            auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+            m_counters.record(type, ret == 0 ? in : 0, out, busy, latency.count(), ret == 0);
+        }
+
+        return ret;
     }
 
-    /* Read a single byte register value from the address.*/
+    /* Read a single byte register value from the address, the address write and the read are one transaction.*/
     char i2c_device::read_register(uint16_t regaddr)
     {
-        write(regaddr);
+        uint8_t reg = regaddr;
         char buffer[1];
 
-        if (::read(fd, buffer, 1) != 1)
+        i2c_msg msgs[2] = {{static_cast<uint16_t>(device), 0, 1, &reg},
+                           {static_cast<uint16_t>(device), I2C_M_RD, 1, reinterpret_cast<uint8_t *>(buffer)}};
+
+        if (transfer(msgs, 2) != 0)
         {
-            std::cerr << "failed to read I2C device file.\n";
             return 1;
         }
         return buffer[0];
     }
 
-    /*Read a number of registers from a single device but the maximum data size is 6.*/
+    /*Read a number of registers from a single device but the maximum data size is 6. Prefer read_burst.*/
     char *i2c_device::read_register(uint16_t number, uint8_t fromaddr)
     {
-        write(fromaddr);
-
-        if (::read(fd, data, number) != static_cast<int>(number))
+        if (number > sizeof(data))
         {
             std::cerr << "failed to read the buffer.\n";
             return nullptr;
         }
+
+        if (read_burst(fromaddr, reinterpret_cast<uint8_t *>(data), number) != 0)
+        {
+            return nullptr;
+        }
         return data;
     }
 
+    /* Read length registers starting from the address straight into the buffer.*/
+    int i2c_device::read_burst(uint8_t fromaddr, uint8_t *buffer, uint16_t length)
+    {
+        if (length > max_burst)
+        {
+            std::cerr << "I2C burst is too long.\n";
+            return 1;
+        }
+
+        i2c_msg msgs[2] = {{static_cast<uint16_t>(device), 0, 1, &fromaddr},
+                           {static_cast<uint16_t>(device), I2C_M_RD, length, buffer}};
+
+        return transfer(msgs, 2);
+    }
+
+    /*
+        Write length registers starting from the address. The address and the
+        data must be one message on the bus, the buffer is used in place when
+        the adapter supports I2C_M_NOSTART and copied behind the address when
+        it does not.
+    */
+    int i2c_device::write_burst(uint8_t fromaddr, const uint8_t *buffer, uint16_t length)
+    {
+        if (length >= max_burst)
+        {
+            std::cerr << "I2C burst is too long.\n";
+            return 1;
+        }
+
+        if (nostart)
+        {
+            i2c_msg msgs[2] = {{static_cast<uint16_t>(device), 0, 1, &fromaddr},
+                               {static_cast<uint16_t>(device), I2C_M_NOSTART, length, const_cast<uint8_t *>(buffer)}};
+
+            return transfer(msgs, 2);
+        }
+
+        uint8_t small[65];
+        std::vector<uint8_t> large;
+        uint8_t *frame = small;
+        if (length >= sizeof(small))
+        {
+            large.resize(length + 1);
+            frame = large.data();
+        }
+
+        frame[0] = fromaddr;
+        std::copy(buffer, buffer + length, frame + 1);
+
+        i2c_msg msg{static_cast<uint16_t>(device), 0, static_cast<uint16_t>(length + 1), frame};
+
+        return transfer(&msg, 1);
+    }
+
+    bbb::async_request i2c_device::submit(std::function<int()> job, bbb::async_options opts)
+    {
+        auto worker = std::atomic_load(&m_worker);
+        if (!worker)
+        {
+            worker = bus_worker::get("i2c-" + std::to_string(bus));
+            std::atomic_store(&m_worker, worker);
+        }
+        return worker->submit(std::move(job), std::move(opts), this);
+    }
+
+    bbb::async_request i2c_device::read_burst_async(uint8_t fromaddr, uint8_t *buffer, uint16_t length, bbb::async_options opts)
+    {
+        return submit([this, fromaddr, buffer, length]
+                      { return read_burst(fromaddr, buffer, length); },
+                      std::move(opts));
+    }
+
+    bbb::async_request i2c_device::write_burst_async(uint8_t fromaddr, const uint8_t *buffer, uint16_t length, bbb::async_options opts)
+    {
+        return submit([this, fromaddr, buffer, length]
+                      { return write_burst(fromaddr, buffer, length); },
+                      std::move(opts));
+    }
+
+    /* The bus is closed with its last device.*/
     void i2c_device::close()
     {
-        ::close(fd);
-        fd = -1;
+        m_bus.reset();
     }
 
     i2c_device::~i2c_device()
     {
-        if (fd != -1)
-            close();
+        if (m_worker)
+            m_worker->cancel(this); // other devices may keep the worker, none of our jobs may run after this
+        m_worker.reset();
+        close();
     }
 
 }
\ No newline at end of file
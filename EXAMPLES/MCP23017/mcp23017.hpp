@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include "i2cdevice.h"
+#include "i2c_regmap.h"
 #include "type_traits"
 
 namespace bbb
@@ -106,85 +107,125 @@ namespace bbb
         */
         uint8_t m_config;
 
+        // SEQOP is set by default, so registers are not read or written as one burst
+        i2c_regmap m_regs{*this, 0x16, false};
+
+        template <typename T>
+        constexpr static bool settable()
+        {
+            using namespace mcp23017_control_reg;
+
+            return !std::is_same_v<T, gpio> && !std::is_same_v<T, iocon> &&
+                   !std::is_same_v<T, intf> && !std::is_same_v<T, intcap>;
+        }
+
     public:
         explicit mcp23017(uint16_t dev, uint16_t addr = 0x20, uint8_t io_conf = 0x3A) : i2c_device{dev, addr},
                                                                                         m_config{io_conf}
         {
+            using namespace mcp23017_control_reg;
+
+            // everything but the input and interrupt state is only changed by us
+            m_regs.set_cacheable(iodir::a, intcon::b);
+            m_regs.set_cacheable(iocon::a, gppu::b);
+            m_regs.set_cacheable(olat::a, olat::b);
+
             configuration(m_config);
         }
 
         template <typename T>
         int set(uint16_t val) // General use for both port A and port B
         {
-            using namespace mcp23017_control_reg;
+            static_assert(settable<T>() && "Cannot set!");
 
-            static_assert(!std::is_same_v<T, gpio> && !std::is_same_v<T, iocon> &&
-                          !std::is_same_v<T, intf> && !std::is_same_v<T, intcap> &&
-                          "Cannot set!");
+            uint8_t values[2] = {static_cast<uint8_t>(val & 0xFF), static_cast<uint8_t>(val >> 8)};
+            return m_regs.write(T::a, values, 2); // T::b follows T::a, one I2C_RDWR
+        }
 
-            write_register(T::a, val & 0xFF);
-            write_register(T::b, val >> 8);
+        template <class T>
+        int set_A(uint8_t val) // only for Port A
+        {
+            static_assert(settable<T>() && "Cannot set!");
 
-            return {};
+            return m_regs.write(T::a, val);
         }
 
         template <class T>
-        int set_A(uint8_t val) // only for Port A
+        int set_B(uint8_t val) // only for Port B
         {
-            using namespace mcp23017_control_reg;
+            static_assert(settable<T>() && "Cannot set!");
 
-            static_assert(!std::is_same_v<T, gpio> && !std::is_same_v<T, iocon> &&
-                          !std::is_same_v<T, intf> && !std::is_same_v<T, intcap> &&
-                          "Cannot set!");
+            return m_regs.write(T::b, val);
+        }
 
-            return write_register(T::a, val);
+        template <typename T>
+        int update(uint16_t mask, uint16_t val) // changes only the masked bits, no bus read for cached registers
+        {
+            static_assert(settable<T>() && "Cannot set!");
+
+            uint8_t cur[2];
+            if (m_regs.read(T::a, cur, 2) != 0)
+                return 1;
+
+            uint8_t next[2] = {static_cast<uint8_t>((cur[0] & ~mask) | (val & mask)),
+                               static_cast<uint8_t>((cur[1] & ~(mask >> 8)) | ((val >> 8) & (mask >> 8)))};
+
+            return m_regs.write(T::a, next, 2);
         }
 
         template <class T>
-        int set_B(uint8_t val) // only for Port B
+        int update_A(uint8_t mask, uint8_t val)
         {
-            using namespace mcp23017_control_reg;
+            static_assert(settable<T>() && "Cannot set!");
+
+            return m_regs.update(T::a, mask, val);
+        }
 
-            static_assert(!std::is_same_v<T, gpio> && !std::is_same_v<T, iocon> &&
-                          !std::is_same_v<T, intf> && !std::is_same_v<T, intcap> &&
-                          "Cannot set!");
+        template <class T>
+        int update_B(uint8_t mask, uint8_t val)
+        {
+            static_assert(settable<T>() && "Cannot set!");
 
-            return write_register(T::b, val);
+            return m_regs.update(T::b, mask, val);
         }
 
         template <typename T>
         uint16_t get() // General use for both port A and port B
         {
-            uint16_t data{0};
-
-            data = read_register(T::b);
-            data = (data << 8) | read_register(T::a);
+            uint8_t data[2]{0};
+            m_regs.read(T::a, data, 2);
 
-            return data;
+            return (data[1] << 8) | data[0];
         }
 
         template <typename T>
         uint8_t get_A() // only for Port A
         {
-            return read_register(T::a);
+            uint8_t data{0};
+            m_regs.read(T::a, data);
+            return data;
         }
 
         template <typename T>
         uint8_t get_B() // only for Port B
         {
-            return read_register(T::b);
+            uint8_t data{0};
+            m_regs.read(T::b, data);
+            return data;
         }
 
         int configuration(uint8_t val)
         {
             using mcp23017_control_reg::iocon;
 
-            write_register(iocon::a, val);
-            write_register(iocon::b, val);
-
-            return 0;
+            uint8_t values[2] = {val, val};
+            return m_regs.write(iocon::a, values, 2);
         }
+
+        void invalidate() { m_regs.invalidate(); } // after a reset of the expander
+
+        using i2c_device::counters;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,79 @@
+/*
+ *  Description : The mcp23017 driver on a simulated i2c-2, no board needed.
+ *                Toggles an output bit with and without the register cache
+ *                and prints the bus transactions and CPU time per toggle.
+ *                usage : mcp23017_sim [toggles]
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "mcp23017.hpp"
+#include "i2c_sim.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+static double cpu_seconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace bbb;
+    using namespace mcp23017_control_reg;
+
+    int toggles = argc > 1 ? std::atoi(argv[1]) : 100'000;
+
+    auto bus = std::make_shared<i2c_sim_bus>(2, 0);
+    auto &chip = bus->attach(0x20, false); // IOCON.SEQOP, the pointer does not move
+
+    chip.regs[iodir::a] = chip.regs[iodir::b] = 0xFF; // inputs after reset
+    chip.regs[iocon::a] = chip.regs[iocon::b] = 0x00;
+
+    // outputs show up on the port, inputs read 0
+    chip.on_write = [&](uint8_t reg, uint8_t val)
+    {
+        if (reg == olat::a || reg == olat::b)
+            chip.regs[reg - 2] = val & ~chip.regs[reg - 0x14];
+    };
+
+    i2c_bus::install(2, bus);
+    mcp23017 mcp{2, 0x20};
+
+    mcp.set_B<iodir>(0x00);
+    mcp.set_B<olat>(0x00);
+
+    auto run = [&](const char *name, auto &&toggle)
+    {
+        bus->clear_stats();
+        double cpu = cpu_seconds();
+        for (int i{0}; i < toggles; i++)
+            toggle(i);
+        cpu = cpu_seconds() - cpu;
+
+        auto st = bus->stats();
+        std::cout << name << double(st.transactions) / toggles << " transactions, "
+                  << double(st.messages) / toggles << " messages, "
+                  << cpu / toggles * 1e9 << " ns CPU per toggle\n";
+    };
+
+    run("get_B + set_B : ", [&](int i)
+        {
+            uint8_t port = mcp.get_B<gpio>();
+            mcp.set_B<olat>((port & ~0x10) | ((i & 1) << 4)); });
+
+    run("update_B      : ", [&](int i)
+        { mcp.update_B<olat>(0x10, (i & 1) << 4); });
+
+    std::cout << "gpio b        : " << +mcp.get_B<gpio>() << '\n'
+              << "mcp23017      : " << mcp.counters().snapshot();
+
+    i2c_bus::install(2, nullptr);
+
+    return 0;
+}
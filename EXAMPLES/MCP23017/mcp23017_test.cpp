@@ -56,6 +56,10 @@ int main()
     print_reg(gpiob, "gpio b : ");
     hold_on_a_moment(1000);
 
+    mcp.update_B<olat>(pin(7), 0); // GPB7 low, olat is cached so this is a single write
+    print_reg(mcp.get_B<gpio>(), "gpio b : ");
+    hold_on_a_moment(1000);
+
     /*
 
         Test 2 : push button, GPA5 in, pull-up 00100000
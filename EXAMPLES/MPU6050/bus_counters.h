@@ -0,0 +1,112 @@
+/*
+ *  Description : Per-device bus instrumentation. Every transaction of an
+ *                i2c_device or spi_device is counted with relaxed atomics,
+ *                no lock on the transfer path : transactions, bytes in and
+ *                out, errors, retries, time on the bus and a latency
+ *                histogram per transaction type. snapshot() copies them
+ *                out and bus_counter_dump prints registered devices
+ *                periodically.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef BUS_COUNTERS_H_
+#define BUS_COUNTERS_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <ostream>
+#include <condition_variable>
+
+namespace bbb
+{
+    enum class xfer_type
+    {
+        read,  // at least one byte from the device
+        write, // only to the device
+        count
+    };
+
+    struct bus_device_stats
+    {
+        constexpr static const int buckets = 16; // bucket 0 : < 2 us, bucket i : [2^i, 2^(i+1)) us
+        constexpr static const int types = static_cast<int>(bbb::xfer_type::count);
+
+        struct per_type
+        {
+            uint64_t transactions{0};
+            uint64_t errors{0};
+            uint64_t bus_ns{0};     // on the wire, without waiting for the bus
+            uint64_t max_ns{0};     // latency, waiting included
+            uint64_t histogram[buckets]{0};
+        } type[types];
+
+        uint64_t bytes_in{0};
+        uint64_t bytes_out{0};
+        uint64_t retries{0};
+
+        uint64_t transactions() const { return type[0].transactions + type[1].transactions; }
+        uint64_t errors() const { return type[0].errors + type[1].errors; }
+        uint64_t bus_ns() const { return type[0].bus_ns + type[1].bus_ns; }
+    };
+
+    class bus_counters
+    {
+    public:
+        void record(bbb::xfer_type t, uint64_t in, uint64_t out, uint64_t bus_ns, uint64_t latency_ns, bool ok);
+        void retry() { m_retries.fetch_add(1, std::memory_order_relaxed); }
+
+        bbb::bus_device_stats snapshot() const;
+        void clear();
+
+    private:
+        constexpr static const int buckets = bbb::bus_device_stats::buckets;
+
+        struct per_type
+        {
+            std::atomic<uint64_t> transactions{0};
+            std::atomic<uint64_t> errors{0};
+            std::atomic<uint64_t> bus_ns{0};
+            std::atomic<uint64_t> max_ns{0};
+            std::atomic<uint64_t> histogram[buckets]{};
+        } m_type[bbb::bus_device_stats::types];
+
+        std::atomic<uint64_t> m_bytes_in{0};
+        std::atomic<uint64_t> m_bytes_out{0};
+        std::atomic<uint64_t> m_retries{0};
+    };
+
+    std::ostream &operator<<(std::ostream &os, const bbb::bus_device_stats &st);
+
+    class bus_counter_dump
+    {
+    public:
+        bus_counter_dump() = default;
+        bus_counter_dump(const bus_counter_dump &) = delete;
+        bus_counter_dump &operator=(const bus_counter_dump &) = delete;
+
+        void add(std::string name, const bbb::bus_counters &counters); // counters must outlive the dump
+
+        void print(std::ostream &os);
+        int start(std::chrono::milliseconds period, std::ostream &os);
+        void stop();
+
+        ~bus_counter_dump();
+
+    private:
+        std::vector<std::pair<std::string, const bbb::bus_counters *>> m_devices;
+
+        std::mutex m_mtx;
+        std::condition_variable m_cv;
+        bool m_running{false};
+        std::thread m_thread;
+    };
+}
+
+#endif
@@ -0,0 +1,182 @@
+/*
+ *  Description : One I2C adapter shared by every i2c_device on it. The bus
+ *                owns a single fd and addresses devices per message with
+ *                I2C_RDWR, so no I2C_SLAVE state is kept on the fd.
+ *                Transactions from several threads are queued in arrival
+ *                order and run back to back; utilization and queue depth
+ *                are counted per bus.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "i2c_bus.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+
+namespace bbb
+{
+    static std::mutex registry_mtx;
+    static std::map<uint32_t, std::weak_ptr<i2c_bus>> registry;
+    static std::map<uint32_t, std::shared_ptr<i2c_bus>> installed;
+
+    /* The bus stays open while a device uses it and is opened again after that. */
+    std::shared_ptr<i2c_bus> i2c_bus::get(uint32_t bus)
+    {
+        std::lock_guard<std::mutex> lock{registry_mtx};
+
+        if (auto it = installed.find(bus); it != installed.end())
+            return it->second;
+
+        auto &slot = registry[bus];
+        auto sp = slot.lock();
+        if (!sp)
+        {
+            sp = std::make_shared<i2c_bus>(bus);
+            slot = sp;
+        }
+
+        return sp;
+    }
+
+    /*
+        Devices created afterwards on this bus number use the replacement, a
+        simulated bus for example. Devices already attached keep their bus.
+    */
+    void i2c_bus::install(uint32_t bus, std::shared_ptr<i2c_bus> replacement)
+    {
+        std::lock_guard<std::mutex> lock{registry_mtx};
+
+        if (replacement)
+            installed[bus] = std::move(replacement);
+        else
+            installed.erase(bus);
+    }
+
+    i2c_bus::i2c_bus(uint32_t bus) : m_number{bus}
+    {
+        std::string path{"/dev/i2c-" + std::to_string(bus)};
+
+        if ((m_fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC)) < 0)
+        {
+            throw std::runtime_error{"Failed to open I2C device file."};
+        }
+
+        if (ioctl(m_fd, I2C_FUNCS, &m_funcs) < 0)
+        {
+            m_funcs = 0;
+        }
+    }
+
+    i2c_bus::i2c_bus(uint32_t bus, unsigned long funcs) : m_number{bus}, m_funcs{funcs}
+    {
+    }
+
+    int i2c_bus::execute(i2c_msg *msgs, uint32_t count)
+    {
+        i2c_rdwr_ioctl_data rdwr{msgs, count};
+
+        return ioctl(m_fd, I2C_RDWR, &rdwr) == static_cast<int>(count) ? 0 : 1;
+    }
+
+    /*
+        Every transaction takes a ticket and waits for its turn, so threads
+        get the bus in the order they asked for it and the next transaction
+        starts as soon as the previous one returns.
+    */
+    int i2c_bus::transfer(i2c_msg *msgs, uint32_t count, uint64_t *busy_ns)
+    {
+        auto queued = clock::now();
+
+        std::unique_lock<std::mutex> lock{m_mtx};
+        uint64_t ticket = m_next++;
+
+        m_stats.depth = m_next - m_serving;
+        if (m_stats.depth > m_stats.max_depth)
+            m_stats.max_depth = m_stats.depth;
+
+        m_turn.wait(lock, [&]
+                    { return m_serving == ticket; });
+        lock.unlock();
+
+        auto start = clock::now();
+        int ret;
+        try
+        {
+            ret = execute(msgs, count);
+        }
+        catch (...)
+        {
+            // the next ticket must still be served, a simulated device callback may throw
+            lock.lock();
+            m_serving++;
+            m_stats.depth = m_next - m_serving;
+            m_stats.transactions++;
+            m_stats.errors++;
+            lock.unlock();
+
+            m_turn.notify_all();
+            throw;
+        }
+        auto end = clock::now();
+
+        lock.lock();
+        m_serving++;
+        m_stats.depth = m_next - m_serving;
+
+        m_stats.transactions++;
+        m_stats.messages += count;
+        for (uint32_t i{0}; i < count; i++)
+            m_stats.bytes += msgs[i].len;
+        if (ret != 0)
+            m_stats.errors++;
+        uint64_t busy = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        m_stats.busy_ns += busy;
+        m_stats.wait_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(start - queued).count();
+        lock.unlock();
+
+        m_turn.notify_all();
+
+        if (busy_ns)
+            *busy_ns = busy;
+        if (ret != 0)
+        {
+            std::cerr << "failed to transfer I2C messages.\n";
+        }
+        return ret;
+    }
+
+    bbb::i2c_bus_stats i2c_bus::stats()
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+
+        auto st = m_stats;
+        st.elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - m_since).count();
+
+        return st;
+    }
+
+    void i2c_bus::clear_stats()
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+
+        auto depth = m_stats.depth;
+        m_stats = {};
+        m_stats.depth = m_stats.max_depth = depth;
+        m_since = clock::now();
+    }
+
+    i2c_bus::~i2c_bus()
+    {
+        if (m_fd != -1)
+            ::close(m_fd);
+    }
+}
@@ -9,6 +9,10 @@
 #define I2CDEVICE_H_
 
 #include <stdint.h>
+#include <memory>
+#include "i2c_bus.h"
+#include "bus_worker.h"
+#include "bus_counters.h"
 
 namespace bbb
 {
@@ -29,6 +33,25 @@ namespace bbb
         char read_register(uint16_t regaddr);
         char *read_register(uint16_t number, uint8_t fromaddr = 0x00);
 
+        // caller buffers of any length up to max_burst, one transaction each
+        int read_burst(uint8_t fromaddr, uint8_t *buffer, uint16_t length);
+        int write_burst(uint8_t fromaddr, const uint8_t *buffer, uint16_t length);
+
+        constexpr static const uint16_t max_burst = 8192; // i2c-dev limit of a message
+
+        int transfer(i2c_msg *msgs, uint32_t count); // one I2C_RDWR, repeated start between messages
+
+        // run on the worker of the bus, the buffers and the device must outlive the request
+        bbb::async_request read_burst_async(uint8_t fromaddr, uint8_t *buffer, uint16_t length, bbb::async_options opts = {});
+        bbb::async_request write_burst_async(uint8_t fromaddr, const uint8_t *buffer, uint16_t length, bbb::async_options opts = {});
+        bbb::async_request submit(std::function<int()> job, bbb::async_options opts = {});
+        uint16_t address() const { return device; }
+        std::shared_ptr<bbb::i2c_bus> get_bus() const { return m_bus; }
+
+        void set_retries(uint8_t retries) { m_retries = retries; } // failed transactions are repeated
+        const bbb::bus_counters &counters() const { return m_counters; }
+        bbb::bus_device_stats stats() const { return m_counters.snapshot(); }
+
         void close();
         ~i2c_device();
 
@@ -37,10 +60,13 @@ namespace bbb
         uint32_t device;
         char data[6]{0};
 
-        int fd = -1;
+        std::shared_ptr<bbb::i2c_bus> m_bus; // one fd per adapter, shared with the other devices
+        bool nostart = false;                // adapter can append a message without a new start
+
+        std::shared_ptr<bbb::bus_worker> m_worker; // started by the first async request
 
-        const char *bbb_12c_1 = "/dev/i2c-1";
-        const char *bbb_12c_2 = "/dev/i2c-2";
+        uint8_t m_retries{0};
+        bbb::bus_counters m_counters;
     };
 
 }
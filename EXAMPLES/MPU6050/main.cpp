@@ -50,8 +50,7 @@ int main()
 
         auto start = std::chrono::steady_clock::now();
 
-        mpu.read_acc();
-        mpu.read_gyr();
+        mpu.read_all();
 
         acc_x = mpu.get_acc_val(axis::x);
         acc_y = mpu.get_acc_val(axis::y);
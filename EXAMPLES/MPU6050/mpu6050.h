@@ -41,6 +41,7 @@ namespace bbb
 
         void read_acc();
         void read_gyr();
+        void read_all(); // acc and gyr in one burst
 
         short get_acc_raw(axis)const;
         short get_gyr_raw(axis)const;
@@ -51,6 +52,8 @@ namespace bbb
         double get_roll()const;               
         double get_pitch()const;
 
+        const bus_counters &counters() const { return m_i2c.counters(); }
+
         ~mpu6050();
 
     private:
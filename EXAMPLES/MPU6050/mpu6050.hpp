@@ -75,7 +75,9 @@ namespace bbb
     template <typename T>
     void mpu6050<T>::read_acc()
     {
-        auto *acc_buffer = m_i2c.read_register(6, reg_acc[0]);
+        uint8_t acc_buffer[6];
+        if (m_i2c.read_burst(reg_acc[0], acc_buffer, sizeof(acc_buffer)) != 0)
+            return;
 
         acc_raw[0] = (int16_t)((acc_buffer[0] << 8) | acc_buffer[1]);
         acc_raw[1] = (int16_t)((acc_buffer[2] << 8) | acc_buffer[3]);
@@ -85,11 +87,28 @@ namespace bbb
     template <typename T>
     void mpu6050<T>::read_gyr()
     {
-        auto *gyr_buffer = m_i2c.read_register(6, reg_gyr[0]);
+        uint8_t gyr_buffer[6];
+        if (m_i2c.read_burst(reg_gyr[0], gyr_buffer, sizeof(gyr_buffer)) != 0)
+            return;
 
-        gyr_raw[0] = ((gyr_buffer[0] << 8) | gyr_buffer[1]);
-        gyr_raw[1] = ((gyr_buffer[2] << 8) | gyr_buffer[3]);
-        gyr_raw[2] = ((gyr_buffer[4] << 8) | gyr_buffer[5]);
+        gyr_raw[0] = (int16_t)((gyr_buffer[0] << 8) | gyr_buffer[1]);
+        gyr_raw[1] = (int16_t)((gyr_buffer[2] << 8) | gyr_buffer[3]);
+        gyr_raw[2] = (int16_t)((gyr_buffer[4] << 8) | gyr_buffer[5]);
+    }
+
+    /* Accelerometer, temperature and gyroscope registers (0x3B - 0x48) in one transaction.*/
+    template <typename T>
+    void mpu6050<T>::read_all()
+    {
+        uint8_t buffer[14];
+        if (m_i2c.read_burst(reg_acc[0], buffer, sizeof(buffer)) != 0)
+            return;
+
+        for (int i{0}; i < 3; i++)
+        {
+            acc_raw[i] = (int16_t)((buffer[2 * i] << 8) | buffer[2 * i + 1]);
+            gyr_raw[i] = (int16_t)((buffer[8 + 2 * i] << 8) | buffer[8 + 2 * i + 1]);
+        }
     }
 
     template <typename T>
@@ -0,0 +1,71 @@
+/*
+ *  Description : The mpu6050 driver on a simulated i2c-2, no board needed.
+ *                Counts the bus transactions of a read and the CPU time the
+ *                driver and the I2C stack spend on it.
+ *                usage : mpu6050_sim [reads]
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include "mpu6050.h"
+#include "i2c_sim.h"
+
+static double cpu_seconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace bbb;
+
+    int reads = argc > 1 ? std::atoi(argv[1]) : 100'000;
+
+    auto bus = std::make_shared<i2c_sim_bus>(2, 400'000);
+    auto &chip = bus->attach(0x68);
+
+    chip.regs[0x75] = 0x68; // WHO_AM_I
+    chip.regs[0x3B + 2] = 0x20; // acc y = +0.5 g at the default range
+    chip.regs[0x3B + 4] = 0x40; // acc z = +1 g
+
+    unsigned tick{0};
+    chip.on_read = [&](uint8_t reg, uint8_t &val)
+    {
+        if (reg == 0x44) // gyro x low byte noise
+            val = (tick++ % 7) * 4;
+    };
+
+    i2c_bus::install(2, bus);
+
+    mpu6050<with_clb> mpu{0}; // calibration reads 1000 samples at 400 kHz timing
+
+    auto init = bus->stats();
+    std::cout << "init     : " << init.transactions << " transactions, "
+              << init.bytes << " bytes, " << bus->bus_ns() / 1e6 << " ms on the bus\n";
+
+    bus->set_clock(0);
+    bus->clear_stats();
+
+    double cpu = cpu_seconds();
+    for (int i{0}; i < reads; i++)
+        mpu.read_all();
+    cpu = cpu_seconds() - cpu;
+
+    auto st = bus->stats();
+    std::cout << "read_all : " << double(st.transactions) / reads << " transactions, "
+              << double(st.bytes) / reads << " bytes, "
+              << cpu / reads * 1e9 << " ns CPU per read\n"
+              << "roll " << mpu.get_roll() << ", pitch " << mpu.get_pitch()
+              << ", gyr x " << mpu.get_gyr_val(axis::x) << '\n'
+              << "mpu6050  : " << mpu.counters().snapshot();
+
+    i2c_bus::install(2, nullptr);
+
+    return 0;
+}
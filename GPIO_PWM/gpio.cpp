@@ -1,132 +1,329 @@
 /*
- *  Description : Simple GPIO interface. m_file always binds the file of
- *                value but other operations can also be done.
+ *  Description : Simple GPIO interface. The sysfs attribute files are opened
+ *                once and accessed with pread/pwrite, direction and
+ *                active_low are cached in the object.
  *  License     : MIT License
  *  Created on  : 2025
  *  Author      : Heval Aktaş
  *  Email       : hevalakts@gmail.com
  */
 #include "gpio.h"
+#include "gpio_cdev.h"
+#include "sysfs_root.h"
 #include <iostream>
 #include <cstring>
 #include <fcntl.h>
 #include <unistd.h>
 #include <thread>
+#include <ctime>
 
-bbb::gpio::gpio(uint16_t number) : m_number{number}, m_path{gpio_path}
+bbb::gpio::gpio(uint16_t number, bbb::backend be) : m_number{number}, m_path{sysfs_root() + gpio_path}, m_backend{be}
 {
     m_path += "gpio" + std::to_string(number) + "/";
 
+    if (m_backend == bbb::backend::chardev)
+    {
+        line_request(0); // direction as-is
+        return;
+    }
+    if (m_backend == bbb::backend::mmap)
+    {
+        line_request(0); // keeps the bank claimed and clocked by the kernel
+        m_bank = bbb::gpio_bank::get(cdev::chip_of(number));
+        m_mask = 1u << cdev::offset_of(number);
+        return;
+    }
+
     gpio_export();
-    open_file((m_path + value).c_str());
+    open_attrs();
 }
 
-bbb::gpio::gpio(uint16_t number, bbb::direction dir) : m_number{number}, m_path{gpio_path}
+bbb::gpio::gpio(uint16_t number, bbb::direction dir, bbb::backend be) : m_number{number}, m_path{sysfs_root() + gpio_path}, m_backend{be}
 {
     m_path += "gpio" + std::to_string(number) + "/";
 
+    if (m_backend == bbb::backend::chardev)
+    {
+        line_request(dir == bbb::direction::in ? GPIO_V2_LINE_FLAG_INPUT : GPIO_V2_LINE_FLAG_OUTPUT);
+        return;
+    }
+    if (m_backend == bbb::backend::mmap)
+    {
+        line_request(dir == bbb::direction::in ? GPIO_V2_LINE_FLAG_INPUT : GPIO_V2_LINE_FLAG_OUTPUT);
+        m_bank = bbb::gpio_bank::get(cdev::chip_of(number));
+        m_mask = 1u << cdev::offset_of(number);
+        return;
+    }
+
     gpio_export();
+    open_attrs();
+    set_direction(dir);
+}
+
+/* mmap backend on an injected register block, no kernel line is claimed. */
+bbb::gpio::gpio(uint16_t number, bbb::direction dir, std::shared_ptr<bbb::gpio_bank> bank)
+    : m_number{number}, m_path{sysfs_root() + gpio_path}, m_backend{bbb::backend::mmap},
+      m_bank{std::move(bank)}, m_mask{1u << cdev::offset_of(number)}
+{
+    m_path += "gpio" + std::to_string(number) + "/";
+
+    set_direction(dir);
+}
+
+/* mmap backend on a fake bank, writes are latched like on the chip. */
+bbb::gpio::gpio(uint16_t number, bbb::direction dir, std::shared_ptr<bbb::fake_gpio_bank> bank)
+    : m_number{number}, m_path{sysfs_root() + gpio_path}, m_backend{bbb::backend::mmap},
+      m_bank{bank}, m_fake{bank.get()}, m_mask{1u << cdev::offset_of(number)}
+{
+    m_path += "gpio" + std::to_string(number) + "/";
+
     set_direction(dir);
 }
 
-int bbb::gpio::open_file(const char *filename)
+int bbb::gpio::line_request(uint64_t flags)
 {
-    m_file.open(filename);
-    if (!m_file.is_open())
+    if ((m_chip = cdev::open_chip(cdev::chip_of(m_number))) == -1)
     {
-        std::cerr << filename << " : the file cannot be opened \n";
         return -1;
     }
+
+    uint32_t offset = cdev::offset_of(m_number);
+    if ((m_line = cdev::request_lines(m_chip, &offset, 1, flags)) == -1)
+    {
+        std::cerr << "gpio" << m_number << " : the line cannot be requested \n";
+        return -1;
+    }
+    m_flags = flags;
+
     return 0;
 }
 
-int bbb::gpio::set(const char *file, const char *val)
+/* Open an attribute of the exported pin once, it is kept for the object's lifetime. */
+int bbb::gpio::open_attr(const char *attr)
 {
-    m_file.close();
+    std::string filename{m_path + attr};
 
-    if (open_file(file) == -1)
+    int fd = ::open(filename.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd == -1)
     {
-        return -1;
+        std::cerr << filename << " : the file cannot be opened \n";
     }
-    m_file << val;
-    m_file.close();
+    return fd;
+}
 
+int bbb::gpio::write_attr(int fd, const char *val)
+{
+    if (::pwrite(fd, val, std::strlen(val), 0) == -1)
+    {
+        return -1;
+    }
     return 0;
 }
 
-int bbb::gpio::set(const char *file, int val)
+int bbb::gpio::write_file(const char *file, int val)
 {
-    m_file.close();
-
-    if (open_file(file) == -1)
+    int fd = ::open(file, O_WRONLY | O_CLOEXEC);
+    if (fd == -1)
     {
+        std::cerr << file << " : the file cannot be opened \n";
         return -1;
     }
-    m_file << val;
-    m_file.close();
 
-    return 0;
+    auto str = std::to_string(val);
+    int ret = ::write(fd, str.c_str(), str.size()) == -1 ? -1 : 0;
+    ::close(fd);
+
+    return ret;
 }
 
-std::string bbb::gpio::get(const char *file)
+/* Open value, direction and active_low and seed the cached state from them. */
+int bbb::gpio::open_attrs()
 {
-    m_file.close();
-    std::string info;
+    if ((m_value_fd = open_attr(value)) == -1 ||
+        (m_direction_fd = open_attr(direction)) == -1 ||
+        (m_active_low_fd = open_attr(active_low)) == -1)
+    {
+        return -1;
+    }
 
-    open_file(file);
-    getline(m_file, info);
-    m_file.close();
+    char buffer[4]{0};
+    if (::pread(m_direction_fd, buffer, sizeof(buffer) - 1, 0) > 0)
+    {
+        m_dir = buffer[0] == 'i' ? bbb::direction::in : bbb::direction::out; // "in", "out", "high", "low"
+    }
+    if (::pread(m_active_low_fd, buffer, 1, 0) > 0)
+    {
+        m_act_low = buffer[0] == '1';
+    }
 
-    return info;
+    return 0;
 }
 
 int bbb::gpio::set_direction(bbb::direction dir)
 {
-    if (dir == bbb::direction::in)
+    if (m_backend == bbb::backend::mmap)
     {
-        set((m_path + direction).c_str(), "in");
+        if (dir == bbb::direction::in)
+            m_bank->set_input(m_mask);
+        else if (m_fake)
+            m_fake->set_output(m_mask);
+        else
+            m_bank->set_output(m_mask);
+
+        return 0;
     }
-    else
+
+    if (m_backend == bbb::backend::chardev)
     {
-        set((m_path + direction).c_str(), "out");
+        uint64_t flags = m_flags & ~(GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_OUTPUT);
+        if (dir == bbb::direction::in)
+        {
+            flags |= GPIO_V2_LINE_FLAG_INPUT;
+        }
+        else
+        {
+            flags &= ~(GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING);
+            flags |= GPIO_V2_LINE_FLAG_OUTPUT;
+        }
+
+        if (cdev::set_config(m_line, flags, 0, 1, flags & GPIO_V2_LINE_FLAG_INPUT ? m_debounce : 0) == -1)
+        {
+            return -1;
+        }
+        m_flags = flags;
+
+        return 0;
+    }
+
+    if (dir == m_dir)
+    {
+        return 0;
+    }
+    if (write_attr(m_direction_fd, dir == bbb::direction::in ? "in" : "out") == -1)
+    {
+        return -1;
     }
+    m_dir = dir;
 
-    return open_file((m_path + value).c_str());
+    return 0;
 }
 
 std::string bbb::gpio::get_direction()
 {
-    auto info = get((m_path + direction).c_str());
+    if (m_backend == bbb::backend::mmap)
+    {
+        return m_bank->is_output(m_mask) ? "out" : "in";
+    }
 
-    open_file((m_path + value).c_str());
+    if (m_backend == bbb::backend::chardev)
+    {
+        uint64_t flags = m_flags;
+        if (!(flags & (GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_OUTPUT)) &&
+            cdev::line_flags(m_chip, cdev::offset_of(m_number), flags) == -1)
+        {
+            return {};
+        }
+        return flags & GPIO_V2_LINE_FLAG_OUTPUT ? "out" : "in";
+    }
 
-    return info;
+    return m_dir == bbb::direction::out ? "out" : "in";
 }
 
 int bbb::gpio::set_value(bbb::value val)
 {
-    m_file << static_cast<bool>(val);
-    m_file.seekp(0);
+    if (m_backend == bbb::backend::mmap)
+    {
+        bool high = (val == bbb::value::high) != m_act_low;
+        if (m_fake)
+            high ? m_fake->set(m_mask) : m_fake->clear(m_mask);
+        else if (high)
+            m_bank->set(m_mask);
+        else
+            m_bank->clear(m_mask);
 
-    return 0;
+        return 0;
+    }
+
+    if (m_backend == bbb::backend::chardev)
+    {
+        return cdev::set_values(m_line, 1, static_cast<uint64_t>(val == bbb::value::high));
+    }
+
+    return write_attr(m_value_fd, val == bbb::value::high ? "1" : "0");
 }
 
 int bbb::gpio::get_value()
 {
-    int value;
-    m_file >> value;
-    m_file.seekg(0);
+    if (m_backend == bbb::backend::mmap)
+    {
+        return ((m_bank->read() & m_mask) != 0) != m_act_low;
+    }
+
+    if (m_backend == bbb::backend::chardev)
+    {
+        uint64_t bits;
+        if (cdev::get_values(m_line, 1, bits) == -1)
+        {
+            return -1;
+        }
+        return bits & 1;
+    }
 
-    return value;
+    char buffer[2];
+    if (::pread(m_value_fd, buffer, sizeof(buffer), 0) < 1)
+    {
+        return -1;
+    }
+    return buffer[0] == '1';
 }
 
 int bbb::gpio::set_active_low(bool act_low)
 {
-    if (set(active_low, act_low) == -1)
+    if (m_backend == bbb::backend::mmap)
+    {
+        m_act_low = act_low;
+        return 0;
+    }
+
+    if (m_backend == bbb::backend::chardev)
+    {
+        uint64_t flags = act_low ? m_flags | GPIO_V2_LINE_FLAG_ACTIVE_LOW
+                                 : m_flags & ~GPIO_V2_LINE_FLAG_ACTIVE_LOW;
+
+        // an output keeps its physical level, the logical value flips with the polarity
+        uint64_t out{0};
+        if (flags & GPIO_V2_LINE_FLAG_OUTPUT)
+        {
+            if (cdev::get_values(m_line, 1, out) == -1)
+            {
+                return -1;
+            }
+            if ((flags ^ m_flags) & GPIO_V2_LINE_FLAG_ACTIVE_LOW)
+            {
+                out ^= 1;
+            }
+        }
+
+        if (cdev::set_config(m_line, flags, out, 1, flags & GPIO_V2_LINE_FLAG_INPUT ? m_debounce : 0) == -1)
+        {
+            return -1;
+        }
+        m_flags = flags;
+
+        return 0;
+    }
+
+    if (act_low == m_act_low)
+    {
+        return 0;
+    }
+    if (write_attr(m_active_low_fd, act_low ? "1" : "0") == -1)
     {
         return -1;
     }
-    return open_file((m_path + value).c_str());
+    m_act_low = act_low;
+
+    return 0;
 }
 
 int bbb::gpio::set_active_high()
@@ -134,25 +331,296 @@ int bbb::gpio::set_active_high()
     return set_active_low(false);
 }
 
-int bbb::gpio::gpio_export()
+int bbb::gpio::set_edge(bbb::edge e, uint32_t debounce_us)
 {
-    int fd;
-    if ((fd = ::open(m_path.c_str(), O_RDONLY)) == -1)
+    m_events.clear();
+
+    if (m_backend == bbb::backend::mmap && m_line == -1)
+    {
+        return -1; // no kernel line behind an injected bank
+    }
+
+    if (m_backend != bbb::backend::sysfs)
     {
-        if (errno == ENOENT)
+        uint64_t flags = m_flags & ~(GPIO_V2_LINE_FLAG_OUTPUT | GPIO_V2_LINE_FLAG_EDGE_RISING |
+                                     GPIO_V2_LINE_FLAG_EDGE_FALLING);
+        flags |= GPIO_V2_LINE_FLAG_INPUT;
+        if (e == bbb::edge::rising || e == bbb::edge::both)
+            flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+        if (e == bbb::edge::falling || e == bbb::edge::both)
+            flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+
+        if (cdev::set_config(m_line, flags, 0, 1, debounce_us) == -1)
         {
-            return set((std::string{gpio_path} + export_p).c_str(), m_number);
+            return -1;
         }
+        m_flags = flags;
+        m_edge = e;
+        m_debounce = debounce_us;
+
+        return 0;
     }
-    std::this_thread::sleep_for(std::chrono::milliseconds{200});
-    ::close(fd);
+
+    constexpr static const char *names[] = {"none", "rising", "falling", "both"};
+
+    if (m_edge_fd == -1 && (m_edge_fd = open_attr(edge)) == -1)
+    {
+        return -1;
+    }
+    if (write_attr(m_edge_fd, names[static_cast<int>(e)]) == -1)
+    {
+        return -1;
+    }
+
+    // consume the current state so that only new edges raise POLLPRI
+    char buffer[4];
+    ::pread(m_value_fd, buffer, sizeof(buffer), 0);
+
+    m_edge = e;
+    m_debounce = debounce_us;
+    m_last_event = 0;
 
     return 0;
 }
 
+pollfd bbb::gpio::event_pollfd() const
+{
+    if (m_backend != bbb::backend::sysfs)
+    {
+        return {m_line, POLLIN, 0};
+    }
+    return {m_value_fd, POLLPRI | POLLERR, 0};
+}
+
+/* Store one sysfs edge, timestamped on wake up and filtered by the debounce time. */
+int bbb::gpio::read_sysfs_event()
+{
+    char buffer[4];
+    if (::pread(m_value_fd, buffer, sizeof(buffer), 0) < 1)
+    {
+        return -1;
+    }
+
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t now = ts.tv_sec * 1'000'000'000ull + ts.tv_nsec;
+
+    if (m_debounce && m_last_event && now - m_last_event < m_debounce * 1000ull)
+    {
+        return 0;
+    }
+    m_last_event = now;
+
+    bbb::edge type = m_edge;
+    if (type == bbb::edge::both)
+        type = buffer[0] == '1' ? bbb::edge::rising : bbb::edge::falling;
+
+    return m_events.push({now, type, ++m_seqno}) ? 1 : 0;
+}
+
+/* Move the pending kernel events into the ring without blocking. */
+int bbb::gpio::read_events()
+{
+    if (m_edge == bbb::edge::none)
+    {
+        return -1;
+    }
+
+    pollfd pfd = event_pollfd();
+    if (poll(&pfd, 1, 0) < 1)
+    {
+        return 0;
+    }
+
+    return drain_events();
+}
+
+/* Read what the fd reported as ready, one read(2) for up to a ring's worth of events. */
+int bbb::gpio::drain_events()
+{
+    if (m_backend == bbb::backend::sysfs)
+    {
+        return read_sysfs_event();
+    }
+
+    gpio_v2_line_event buffer[event_capacity];
+    std::size_t count = m_events.free() ? m_events.free() : 1; // full ring still drains the kernel fifo
+
+    ssize_t len = ::read(m_line, buffer, count * sizeof(buffer[0]));
+    if (len < 0)
+    {
+        return -1;
+    }
+
+    int n = len / sizeof(buffer[0]);
+    for (int i{0}; i < n; i++)
+    {
+        auto type = buffer[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE ? bbb::edge::rising : bbb::edge::falling;
+        m_events.push({buffer[i].timestamp_ns, type, buffer[i].seqno});
+    }
+
+    return n;
+}
+
+/* Wait for an edge : 1 on event, 0 on timeout and -1 on error. A negative timeout blocks. */
+int bbb::gpio::wait_event(bbb::gpio_event &ev, int timeout_ms)
+{
+    if (m_edge == bbb::edge::none)
+    {
+        return -1;
+    }
+
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while (!m_events.pop(ev))
+    {
+        int wait = timeout_ms;
+        if (timeout_ms > 0)
+        {
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            wait -= (now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1'000'000;
+            if (wait <= 0)
+                return 0;
+        }
+
+        pollfd pfd = event_pollfd();
+        int ret = poll(&pfd, 1, wait);
+        if (ret == 0)
+        {
+            return 0;
+        }
+        if (ret < 0 && errno != EINTR)
+        {
+            return -1;
+        }
+        if (ret > 0 && drain_events() < 0)
+        {
+            return -1;
+        }
+    }
+
+    return 1;
+}
+
+int bbb::gpio::gpio_export()
+{
+    return export_pins({m_number}).front().status;
+}
+
+/* A pin is usable once udev has made its value attribute accessible. */
+static bool attr_ready(const std::string &pin_path)
+{
+    return ::access((pin_path + "value").c_str(), R_OK | W_OK) == 0;
+}
+
+/*
+    Export all pins in one pass and then wait until their attribute files
+    appear, polling against a deadline instead of a fixed sleep. Pins that
+    are already exported are not waited for.
+*/
+std::vector<bbb::bringup> bbb::gpio::export_pins(const std::vector<uint16_t> &numbers,
+                                                 std::chrono::milliseconds timeout)
+{
+    using namespace std::chrono;
+    auto start = steady_clock::now();
+
+    std::vector<bbb::bringup> pins;
+    std::vector<std::string> paths;
+    std::vector<bool> wait;
+    int fd{-1};
+
+    for (auto number : numbers)
+    {
+        std::string path{sysfs_root() + gpio_path};
+        path += "gpio" + std::to_string(number) + "/";
+
+        bbb::bringup pin{number, -1, false, {}};
+        if (attr_ready(path))
+        {
+            pin.status = 0;
+        }
+        else if (::access(path.c_str(), F_OK) == -1)
+        {
+            if (fd == -1 && (fd = ::open((sysfs_root() + gpio_path + export_p).c_str(), O_WRONLY | O_CLOEXEC)) == -1)
+            {
+                std::cerr << gpio_path << export_p << " : the file cannot be opened \n";
+            }
+
+            auto str = std::to_string(number);
+            if (fd != -1 && ::write(fd, str.c_str(), str.size()) != -1)
+            {
+                pin.exported = true;
+            }
+            else
+            {
+                std::cerr << "gpio" << number << " : cannot be exported \n";
+            }
+        }
+        pin.elapsed = duration_cast<microseconds>(steady_clock::now() - start);
+
+        // also wait for pins exported elsewhere whose attributes udev has not fixed up yet
+        wait.push_back(pin.status != 0 && (pin.exported || ::access(path.c_str(), F_OK) == 0));
+        pins.push_back(pin);
+        paths.push_back(std::move(path));
+    }
+
+    if (fd != -1)
+        ::close(fd);
+
+    auto deadline = start + timeout;
+    for (;;)
+    {
+        bool pending{false};
+        for (std::size_t i{0}; i < pins.size(); i++)
+        {
+            if (!wait[i] || pins[i].status == 0)
+                continue;
+
+            if (attr_ready(paths[i]))
+            {
+                pins[i].status = 0;
+                pins[i].elapsed = duration_cast<microseconds>(steady_clock::now() - start);
+            }
+            else
+            {
+                pending = true;
+            }
+        }
+
+        if (!pending || steady_clock::now() > deadline)
+            break;
+        std::this_thread::sleep_for(milliseconds{1});
+    }
+
+    return pins;
+}
+
 int bbb::gpio::gpio_unexport()
 {
-    return set((std::string{gpio_path} + unexport_p).c_str(), m_number);
+    if (m_backend != bbb::backend::sysfs)
+    {
+        // releasing the line request is the chardev equivalent of unexport
+        if (m_line != -1)
+            ::close(m_line);
+        m_line = -1;
+
+        return 0;
+    }
+
+    return write_file((sysfs_root() + gpio_path + unexport_p).c_str(), m_number);
 }
 
-bbb::gpio::~gpio() {}
\ No newline at end of file
+bbb::gpio::~gpio()
+{
+    for (int fd : {m_value_fd, m_direction_fd, m_active_low_fd, m_edge_fd})
+    {
+        if (fd != -1)
+            ::close(fd);
+    }
+    if (m_line != -1)
+        ::close(m_line);
+    if (m_chip != -1)
+        ::close(m_chip);
+}
\ No newline at end of file
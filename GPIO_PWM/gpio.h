@@ -1,6 +1,12 @@
 /*
- *  Description : Simple GPIO interface. m_file, always binds the file of
- *                value but other operations can also be done.
+ *  Description : Simple GPIO interface. The sysfs attribute files are opened
+ *                once and accessed with pread/pwrite, direction and
+ *                active_low are cached in the object. The chardev
+ *                backend drives the pin through a /dev/gpiochipN line
+ *                request instead of sysfs. Edge events are collected
+ *                into a fixed-capacity ring with kernel timestamps.
+ *                The mmap backend claims the line through chardev but
+ *                drives it with stores to the AM335x bank registers.
  *  License     : MIT License
  *  Created on  : 2025
  *  Author      : Heval Aktaş
@@ -10,7 +16,13 @@
 #define GPIO_H_
 
 #include <string>
-#include <fstream>
+#include <stdint.h>
+#include <poll.h>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include "gpio_event.h"
+#include "gpio_mmap.h"
 
 namespace bbb
 {
@@ -24,12 +36,28 @@ namespace bbb
         low,
         high
     };
+    enum class backend
+    {
+        sysfs,
+        chardev,
+        mmap
+    };
+
+    struct bringup // result of exporting a pin
+    {
+        uint16_t number;
+        int status;    // 0 ready, -1 failed or timed out
+        bool exported; // false if the pin was already exported
+        std::chrono::microseconds elapsed;
+    };
 
     class gpio
     {
     public:
-        explicit gpio(uint16_t number);
-        gpio(uint16_t number, bbb::direction dir);
+        explicit gpio(uint16_t number, bbb::backend be = bbb::backend::sysfs);
+        gpio(uint16_t number, bbb::direction dir, bbb::backend be = bbb::backend::sysfs);
+        gpio(uint16_t number, bbb::direction dir, std::shared_ptr<bbb::gpio_bank> bank);
+        gpio(uint16_t number, bbb::direction dir, std::shared_ptr<bbb::fake_gpio_bank> bank);
         gpio(const gpio &other) = delete;
         gpio &operator=(const gpio &other) = delete;
 
@@ -42,30 +70,75 @@ namespace bbb
         int set_active_low(bool act_low = true);
         int set_active_high();
 
+        int set_edge(bbb::edge e, uint32_t debounce_us = 0);
+        int wait_event(bbb::gpio_event &ev, int timeout_ms = -1);
+        int read_events();
+        bool pop_event(bbb::gpio_event &ev) { return m_events.pop(ev); }
+        uint64_t dropped_events() const { return m_events.dropped(); }
+        pollfd event_pollfd() const;
+
         int gpio_unexport();
 
+        static std::vector<bbb::bringup> export_pins(const std::vector<uint16_t> &numbers,
+                                                     std::chrono::milliseconds timeout = std::chrono::milliseconds{1000});
+
+        bbb::backend get_backend() const { return m_backend; }
+
+        // mmap : register block and bit of the pin, to write several pins of a bank at once
+        bbb::gpio_bank *get_bank() const { return m_bank.get(); }
+        bbb::fake_gpio_bank *get_fake_bank() const { return m_fake; } // null on a real bank
+        uint32_t bank_mask() const { return m_mask; }
+        bool is_active_low() const { return m_act_low; }
+
         ~gpio();
 
     private:
         int gpio_export();
+        int line_request(uint64_t flags);
+        int drain_events();
+        int read_sysfs_event();
 
-        int open_file(const char *);
-        int set(const char *file, int val);
-        int set(const char *file, const char *val);
-        std::string get(const char *file);
+        int open_attrs();
+        int open_attr(const char *attr);
+        int write_attr(int fd, const char *val);
+        int write_file(const char *file, int val);
 
         constexpr static const char gpio_path[] = "/sys/class/gpio/";
 
         constexpr static const char active_low[] = "active_low";
         constexpr static const char direction[] = "direction";
         constexpr static const char value[] = "value";
+        constexpr static const char edge[] = "edge";
         constexpr static const char export_p[] = "export";
         constexpr static const char unexport_p[] = "unexport";
 
         uint16_t m_number;
         std::string m_path;
+        bbb::backend m_backend;
+
+        int m_value_fd{-1};      // sysfs
+        int m_direction_fd{-1};  // sysfs
+        int m_active_low_fd{-1}; // sysfs
+        int m_edge_fd{-1};       // sysfs, opened on first set_edge
+
+        bbb::direction m_dir{bbb::direction::in}; // sysfs : cached
+
+        int m_chip{-1};      // chardev : /dev/gpiochipN
+        int m_line{-1};      // chardev : line request fd
+        uint64_t m_flags{0}; // chardev : requested line flags
+
+        std::shared_ptr<bbb::gpio_bank> m_bank; // mmap
+        bbb::fake_gpio_bank *m_fake{nullptr};   // mmap : m_bank when it is a fake
+        uint32_t m_mask{0};                     // mmap : bit of the pin in its bank
+        bool m_act_low{false};                  // sysfs : cached, mmap : inverted in software
+
+        constexpr static const std::size_t event_capacity = 64;
 
-        std::fstream m_file;
+        bbb::edge m_edge{bbb::edge::none};
+        uint32_t m_debounce{0}; // us, software filtered on sysfs
+        uint64_t m_last_event{0};
+        uint32_t m_seqno{0};
+        bbb::event_ring<bbb::gpio_event, event_capacity> m_events;
     };
 }
 
@@ -0,0 +1,264 @@
+/*
+ *  Description : Latency benchmarks of the gpio and pwm paths. Every
+ *                operation is timed one by one, in a tight loop and in a
+ *                periodic loop, and reported as ops/s with min, median,
+ *                p99, p99.9 and max latency.
+ *                usage : gpio_bench [gpio number] [iterations] [-v]
+ *                        gpio_bench fake [iterations] [-v]
+ *                "fake" builds a sysfs tree in a temporary directory and
+ *                uses a memfd gpio bank, so it runs on any Linux machine.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "gpio.h"
+#include "pwm.h"
+#include "rt_thread.h"
+#include "sysfs_root.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <sys/stat.h>
+
+namespace
+{
+    bool verbose{false};
+    uint64_t failed_calls{0}; // of every benchmark, a failing call is not a valid sample
+
+    struct samples
+    {
+        std::vector<uint64_t> ns;
+        uint64_t total_ns{0};
+        uint64_t failures{0};
+
+        uint64_t at(double q) const { return ns[std::min(ns.size() - 1, static_cast<std::size_t>(q * ns.size()))]; }
+    };
+
+    /* Time every call of op, back to back or on an absolute period. */
+    samples measure(long iterations, uint64_t period_ns, const std::function<int(long)> &op)
+    {
+        samples s;
+        s.ns.reserve(iterations);
+
+        uint64_t start = bbb::rt::now_ns();
+        uint64_t deadline = start;
+
+        for (long i{0}; i < iterations; i++)
+        {
+            if (period_ns)
+            {
+                deadline += period_ns;
+                bbb::rt::sleep_until(deadline);
+            }
+
+            uint64_t t0 = bbb::rt::now_ns();
+            int ret = op(i);
+            s.ns.push_back(bbb::rt::now_ns() - t0);
+
+            if (ret == -1)
+                s.failures++;
+        }
+
+        s.total_ns = bbb::rt::now_ns() - start;
+        std::sort(s.ns.begin(), s.ns.end());
+
+        return s;
+    }
+
+    void header()
+    {
+        std::cout << std::left << std::setw(30) << "operation" << std::right
+                  << std::setw(12) << "ops/s"
+                  << std::setw(10) << "min"
+                  << std::setw(10) << "p50"
+                  << std::setw(10) << "p99"
+                  << std::setw(10) << "p99.9"
+                  << std::setw(10) << "max" << "   (us)\n";
+    }
+
+    void report(const std::string &name, const samples &s)
+    {
+        if (s.ns.empty())
+            return;
+
+        if (s.failures)
+        {
+            std::cout << std::left << std::setw(30) << name << std::right << "   failed "
+                      << s.failures << " of " << s.ns.size() << " calls\n";
+            failed_calls += s.failures;
+            return;
+        }
+
+        std::cout << std::fixed << std::setprecision(0)
+                  << std::left << std::setw(30) << name << std::right
+                  << std::setw(12) << s.ns.size() * 1e9 / s.total_ns
+                  << std::setprecision(2)
+                  << std::setw(10) << s.ns.front() / 1000.
+                  << std::setw(10) << s.at(0.5) / 1000.
+                  << std::setw(10) << s.at(0.99) / 1000.
+                  << std::setw(10) << s.at(0.999) / 1000.
+                  << std::setw(10) << s.ns.back() / 1000. << '\n';
+
+        if (!verbose)
+            return;
+
+        bbb::rt::lateness hist;
+        for (auto ns : s.ns)
+            hist.add(ns);
+        for (int i{0}; i < bbb::rt::lateness::buckets; i++)
+        {
+            if (hist.histogram[i])
+                std::cout << "    < " << std::setw(6) << (2u << i) << " us : " << hist.histogram[i] << '\n';
+        }
+    }
+
+    /* Tight loop first, then the same operation every 100 us. */
+    void run(const std::string &name, long iterations, const std::function<int(long)> &op)
+    {
+        report(name, measure(iterations, 0, op));
+        report(name + " @10kHz", measure(std::min(iterations, 10'000l), 100'000, op));
+    }
+
+    void bench_gpio(const std::string &name, bbb::gpio &pin, long iterations)
+    {
+        run(name + " set_value", iterations, [&](long i)
+            { return pin.set_value(i & 1 ? bbb::value::low : bbb::value::high); });
+        run(name + " get_value", iterations, [&](long)
+            { return pin.get_value() == -1 ? -1 : 0; });
+        run(name + " set_direction", iterations / 10, [&](long i)
+            { return pin.set_direction(i & 1 ? bbb::direction::out : bbb::direction::in); });
+        pin.set_direction(bbb::direction::out);
+    }
+
+    void bench_pwm(bbb::pwm &pwm, long iterations)
+    {
+        pwm.set_period(20'000'000u);
+        run("pwm set_duty_cycle(ns)", iterations, [&](long i)
+            { return pwm.set_duty_cycle(static_cast<uint32_t>(1'000'000 + (i & 1023) * 1000)); });
+        run("pwm set_duty_cycle(%)", iterations, [&](long i)
+            { return pwm.set_duty_cycle(2.5 + (i & 1023) / 100.); });
+        run("pwm set_period", iterations, [&](long i)
+            { return pwm.set_period(20'000'000u + (i & 1)); });
+    }
+
+    void write_file(const std::string &path, const char *content)
+    {
+        std::ofstream{path} << content;
+    }
+
+    /* Removes the fake tree on exit. */
+    struct temp_tree
+    {
+        std::string path;
+
+        ~temp_tree()
+        {
+            std::error_code ec;
+            if (!path.empty())
+                std::filesystem::remove_all(path, ec);
+        }
+    };
+
+    /* Exported gpio60 and the P9_16 pwm (ehrpwm1b) as plain files. */
+    std::string make_fake_tree()
+    {
+        char dir[] = "/tmp/bbb_sysfs_XXXXXX";
+        if (!mkdtemp(dir))
+            return {};
+
+        std::string root{dir};
+        for (auto sub : {"/sys", "/sys/class", "/sys/class/gpio", "/sys/class/gpio/gpio60",
+                         "/sys/devices", "/sys/devices/platform", "/sys/devices/platform/ocp",
+                         "/sys/devices/platform/ocp/ocp:P9_16_pinmux",
+                         "/dev", "/dev/bone", "/dev/bone/pwm", "/dev/bone/pwm/1", "/dev/bone/pwm/1/b"})
+            mkdir((root + sub).c_str(), 0755);
+
+        write_file(root + "/sys/class/gpio/export", "");
+        write_file(root + "/sys/class/gpio/unexport", "");
+        write_file(root + "/sys/class/gpio/gpio60/value", "0\n");
+        write_file(root + "/sys/class/gpio/gpio60/direction", "in\n");
+        write_file(root + "/sys/class/gpio/gpio60/active_low", "0\n");
+        write_file(root + "/sys/devices/platform/ocp/ocp:P9_16_pinmux/state", "default\n");
+        write_file(root + "/dev/bone/pwm/1/b/period", "0\n");
+        write_file(root + "/dev/bone/pwm/1/b/duty_cycle", "0\n");
+        write_file(root + "/dev/bone/pwm/1/b/enable", "0\n");
+        write_file(root + "/dev/bone/pwm/1/b/polarity", "normal\n");
+
+        return root;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<const char *> args;
+    for (int i{0}; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-v") == 0)
+            verbose = true;
+        else
+            args.push_back(argv[i]);
+    }
+
+    bool fake = args.size() > 1 && std::strcmp(args[1], "fake") == 0;
+    uint16_t number = args.size() > 1 && !fake ? std::atoi(args[1]) : 60; // P9_12
+    long iterations = args.size() > 2 ? std::atol(args[2]) : 100'000;
+
+    temp_tree tree;
+    if (fake)
+    {
+        tree.path = make_fake_tree();
+        if (tree.path.empty())
+        {
+            std::cerr << "fake sysfs tree cannot be created\n";
+            return 1;
+        }
+        bbb::set_sysfs_root(tree.path);
+        std::cout << "fake tree : " << tree.path << "\n";
+    }
+
+    std::cout << "gpio" << number << ", " << iterations << " iterations\n";
+    header();
+    {
+        bbb::gpio pin{number, bbb::direction::out, bbb::backend::sysfs};
+        bench_gpio("sysfs", pin, iterations);
+        if (!fake)
+            pin.gpio_unexport(); // the line is busy for chardev while exported
+    }
+    if (!fake)
+    {
+        bbb::gpio pin{number, bbb::direction::out, bbb::backend::chardev};
+        bench_gpio("chardev", pin, iterations);
+    }
+    try
+    {
+        auto pin = fake ? std::make_unique<bbb::gpio>(number, bbb::direction::out, bbb::gpio_bank::fake())
+                        : std::make_unique<bbb::gpio>(number, bbb::direction::out, bbb::backend::mmap);
+        bench_gpio("mmap", *pin, iterations * 10);
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout << "mmap skipped : " << e.what() << '\n'; // /dev/mem needs root
+    }
+    {
+        bbb::pwm pwm{16};
+        bench_pwm(pwm, iterations);
+    }
+
+    if (failed_calls)
+    {
+        std::cerr << failed_calls << " calls failed, their timings are not reported\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ *  Description : Timestamped GPIO edge events and a fixed-capacity ring
+ *                to hold them. The ring never allocates; when it is full
+ *                the newest event is dropped and counted.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef GPIO_EVENT_H_
+#define GPIO_EVENT_H_
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace bbb
+{
+    enum class edge
+    {
+        none,
+        rising,
+        falling,
+        both
+    };
+
+    struct gpio_event
+    {
+        uint64_t timestamp_ns; // CLOCK_MONOTONIC
+        bbb::edge type;        // rising or falling
+        uint32_t seqno;
+    };
+
+    template <typename T, std::size_t N>
+    class event_ring
+    {
+        static_assert(N && !(N & (N - 1)), "ring capacity must be a power of two");
+
+        T m_buffer[N];
+        std::size_t m_head{0}; // next slot to pop
+        std::size_t m_tail{0}; // next slot to push
+        uint64_t m_dropped{0};
+
+    public:
+        bool push(const T &val)
+        {
+            if (full())
+            {
+                m_dropped++;
+                return false;
+            }
+            m_buffer[m_tail++ & (N - 1)] = val;
+            return true;
+        }
+
+        bool pop(T &val)
+        {
+            if (empty())
+                return false;
+            val = m_buffer[m_head++ & (N - 1)];
+            return true;
+        }
+
+        void clear() { m_head = m_tail; }
+
+        std::size_t size() const { return m_tail - m_head; }
+        std::size_t free() const { return N - size(); }
+        constexpr static std::size_t capacity() { return N; }
+
+        bool empty() const { return m_head == m_tail; }
+        bool full() const { return size() == N; }
+
+        uint64_t dropped() const { return m_dropped; }
+    };
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ *  Description : Memory-mapped AM335x GPIO bank. Pins are driven with
+ *                plain stores to SETDATAOUT/CLEARDATAOUT, no syscall per
+ *                edge. The register block can be injected from any fd, e.g.
+ *                a memfd standing in for the hardware on a dev machine.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef GPIO_MMAP_H_
+#define GPIO_MMAP_H_
+
+#include <stdint.h>
+#include <cstddef>
+#include <memory>
+#include <sys/types.h>
+
+namespace bbb
+{
+    namespace am335x
+    {
+        // AM335x TRM, chapter 25.4 GPIO registers
+        constexpr static const uint32_t gpio_base[] = {0x44E07000, 0x4804C000, 0x481AC000, 0x481AE000};
+        constexpr static const std::size_t gpio_size = 0x1000;
+
+        constexpr static const uint32_t gpio_oe = 0x134; // 1 -> in, 0 -> out
+        constexpr static const uint32_t gpio_datain = 0x138;
+        constexpr static const uint32_t gpio_dataout = 0x13C;
+        constexpr static const uint32_t gpio_cleardataout = 0x190;
+        constexpr static const uint32_t gpio_setdataout = 0x194;
+    }
+
+    class fake_gpio_bank;
+
+    class gpio_bank
+    {
+    public:
+        explicit gpio_bank(uint16_t bank);
+        gpio_bank(int fd, off_t offset);
+        gpio_bank(const gpio_bank &) = delete;
+        gpio_bank &operator=(const gpio_bank &) = delete;
+
+        static std::shared_ptr<gpio_bank> get(uint16_t bank);
+        static std::shared_ptr<fake_gpio_bank> fake();
+
+        volatile uint32_t &reg(uint32_t offset) { return m_regs[offset / sizeof(uint32_t)]; }
+
+        void set(uint32_t mask) { reg(am335x::gpio_setdataout) = mask; }
+        void clear(uint32_t mask) { reg(am335x::gpio_cleardataout) = mask; }
+        uint32_t read() { return reg(am335x::gpio_datain); }
+
+        // OE is read-modify-write, direction changes are not atomic against other users of the bank
+        void set_input(uint32_t mask)
+        {
+            uint32_t oe = reg(am335x::gpio_oe);
+            reg(am335x::gpio_oe) = oe | mask;
+        }
+        void set_output(uint32_t mask)
+        {
+            uint32_t oe = reg(am335x::gpio_oe);
+            reg(am335x::gpio_oe) = oe & ~mask;
+        }
+        bool is_output(uint32_t mask) { return !(reg(am335x::gpio_oe) & mask); }
+
+        ~gpio_bank();
+
+    private:
+        void map(int fd, off_t offset);
+
+        constexpr static const char mem_path[] = "/dev/mem";
+
+        volatile uint32_t *m_regs{nullptr};
+    };
+
+    /*
+        Register block in anonymous memory standing in for a bank, no hardware
+        needed. Its set/clear/set_output hide the ones of gpio_bank and latch
+        the writes into DATAOUT and DATAIN like the chip does, so the stores
+        of a real bank stay free of any test code.
+    */
+    class fake_gpio_bank : public gpio_bank
+    {
+    public:
+        fake_gpio_bank();
+
+        void set(uint32_t mask)
+        {
+            gpio_bank::set(mask);
+            latch();
+        }
+        void clear(uint32_t mask)
+        {
+            gpio_bank::clear(mask);
+            latch();
+        }
+        void set_output(uint32_t mask)
+        {
+            gpio_bank::set_output(mask);
+            latch();
+        }
+
+    private:
+        explicit fake_gpio_bank(int fd);
+        void latch();
+    };
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ *  Description : Level test of the mmap backend on a fake gpio bank. Pins
+ *                are set and cleared, and read back through DATAIN.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "gpio.h"
+
+#include <iostream>
+
+static int failures{0};
+
+static void check(const char *what, int got, int expected)
+{
+    if (got != expected)
+    {
+        std::cerr << what << " : read " << got << ", expected " << expected << '\n';
+        failures++;
+    }
+}
+
+int main()
+{
+    auto bank = bbb::gpio_bank::fake();
+
+    bbb::gpio clk{60, bbb::direction::out, bank};    // P9_12, bank 1 bit 28
+    bbb::gpio strobe{48, bbb::direction::out, bank}; // P9_15, bank 1 bit 16
+    bbb::gpio button{49, bbb::direction::in, bank};  // P9_23, bank 1 bit 17
+
+    check("clk after start", clk.get_value(), 0);
+
+    clk.set_value(bbb::value::high);
+    check("clk set", clk.get_value(), 1);
+    check("strobe untouched", strobe.get_value(), 0);
+
+    strobe.set_value(bbb::value::high);
+    clk.set_value(bbb::value::low);
+    check("clk cleared", clk.get_value(), 0);
+    check("strobe set", strobe.get_value(), 1);
+
+    bank->set(1u << 17);
+    check("input ignores DATAOUT", button.get_value(), 0);
+
+    bank->set((1u << 28) | (1u << 16));
+    bank->clear(1u << 16);
+    check("clk in one store", clk.get_value(), 1);
+    check("strobe in one store", strobe.get_value(), 0);
+
+    std::cout << (failures ? "FAILED" : "passed") << '\n';
+
+    return failures ? 1 : 0;
+}
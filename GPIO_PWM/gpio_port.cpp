@@ -0,0 +1,198 @@
+/*
+ *  Description : A set of GPIO lines claimed together. Bit i of a mask
+ *                refers to the i-th pin given to the constructor. With the
+ *                chardev backend all lines of a chip are changed by a
+ *                single GPIO_V2_LINE_SET_VALUES call. The sysfs backend
+ *                writes the pins one by one, mmap is not supported.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "gpio_port.h"
+#include "gpio_cdev.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace bbb
+{
+
+    static uint64_t dir_flags(bbb::direction dir)
+    {
+        return dir == bbb::direction::in ? GPIO_V2_LINE_FLAG_INPUT : GPIO_V2_LINE_FLAG_OUTPUT;
+    }
+
+    gpio_port::gpio_port(std::initializer_list<uint16_t> numbers, bbb::direction dir, bbb::backend be)
+        : m_size{numbers.size()}, m_backend{be}
+    {
+        if (m_size == 0 || m_size > max_lines)
+        {
+            throw std::runtime_error{"invalid number of lines for gpio_port"};
+        }
+
+        if (m_backend == bbb::backend::sysfs)
+        {
+            for (auto number : numbers)
+                m_pins.push_back(std::make_unique<bbb::gpio>(number, dir, bbb::backend::sysfs));
+            return;
+        }
+        if (m_backend != bbb::backend::chardev)
+        {
+            throw std::runtime_error{"gpio_port supports the sysfs and chardev backends only"};
+        }
+
+        uint8_t bit{0};
+        for (auto number : numbers)
+        {
+            auto chip = cdev::chip_of(number);
+
+            auto it = m_chips.begin();
+            while (it != m_chips.end() && it->chip != chip)
+                ++it;
+            if (it == m_chips.end())
+            {
+                m_chips.emplace_back();
+                it = m_chips.end() - 1;
+                it->chip = chip;
+            }
+
+            it->offsets.push_back(cdev::offset_of(number));
+            it->bits.push_back(bit++);
+        }
+
+        for (auto &c : m_chips)
+        {
+            if ((c.chip_fd = cdev::open_chip(c.chip)) == -1 ||
+                (c.line_fd = cdev::request_lines(c.chip_fd, c.offsets.data(), c.offsets.size(), dir_flags(dir))) == -1)
+            {
+                release();
+                throw std::runtime_error{"gpio_port lines cannot be requested"};
+            }
+        }
+    }
+
+    uint32_t gpio_port::all() const
+    {
+        return m_size == max_lines ? ~0u : (1u << m_size) - 1;
+    }
+
+    int gpio_port::set_direction(bbb::direction dir)
+    {
+        for (auto &pin : m_pins)
+        {
+            if (pin->set_direction(dir) == -1)
+                return -1;
+        }
+
+        for (auto &c : m_chips)
+        {
+            if (cdev::set_config(c.line_fd, dir_flags(dir), 0, c.offsets.size()) == -1)
+                return -1;
+        }
+
+        return 0;
+    }
+
+    int gpio_port::set(uint32_t mask, uint32_t values)
+    {
+        mask &= all();
+
+        if (m_backend == bbb::backend::sysfs)
+        {
+            for (std::size_t i{0}; i < m_size; i++)
+            {
+                if (mask >> i & 1 &&
+                    m_pins[i]->set_value(values >> i & 1 ? bbb::value::high : bbb::value::low) == -1)
+                {
+                    std::cerr << "gpio_port : Can't set values\n";
+                    return -1;
+                }
+            }
+            return 0;
+        }
+
+        for (auto &c : m_chips)
+        {
+            uint64_t line_mask{0};
+            uint64_t line_bits{0};
+
+            for (std::size_t j{0}; j < c.bits.size(); j++)
+            {
+                line_mask |= static_cast<uint64_t>(mask >> c.bits[j] & 1) << j;
+                line_bits |= static_cast<uint64_t>(values >> c.bits[j] & 1) << j;
+            }
+
+            if (line_mask && cdev::set_values(c.line_fd, line_mask, line_bits) == -1)
+            {
+                std::cerr << "gpio_port : Can't set values\n";
+                return -1;
+            }
+        }
+
+        return 0;
+    }
+
+    int gpio_port::get(uint32_t &values, uint32_t mask)
+    {
+        mask &= all();
+        values = 0;
+
+        if (m_backend == bbb::backend::sysfs)
+        {
+            for (std::size_t i{0}; i < m_size; i++)
+            {
+                if (!(mask >> i & 1))
+                    continue;
+
+                int val = m_pins[i]->get_value();
+                if (val == -1)
+                {
+                    std::cerr << "gpio_port : Can't get values\n";
+                    return -1;
+                }
+                values |= static_cast<uint32_t>(val == 1) << i;
+            }
+            return 0;
+        }
+
+        for (auto &c : m_chips)
+        {
+            uint64_t line_mask{0};
+            for (std::size_t j{0}; j < c.bits.size(); j++)
+                line_mask |= static_cast<uint64_t>(mask >> c.bits[j] & 1) << j;
+
+            uint64_t line_bits;
+            if (!line_mask)
+                continue;
+            if (cdev::get_values(c.line_fd, line_mask, line_bits) == -1)
+            {
+                std::cerr << "gpio_port : Can't get values\n";
+                return -1;
+            }
+
+            for (std::size_t j{0}; j < c.bits.size(); j++)
+                values |= static_cast<uint32_t>(line_bits >> j & 1) << c.bits[j];
+        }
+
+        return 0;
+    }
+
+    void gpio_port::release()
+    {
+        for (auto &c : m_chips)
+        {
+            if (c.line_fd != -1)
+                ::close(c.line_fd);
+            if (c.chip_fd != -1)
+                ::close(c.chip_fd);
+            c.line_fd = c.chip_fd = -1;
+        }
+    }
+
+    gpio_port::~gpio_port()
+    {
+        release();
+    }
+}
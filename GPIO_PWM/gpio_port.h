@@ -0,0 +1,65 @@
+/*
+ *  Description : A set of GPIO lines claimed together. Bit i of a mask
+ *                refers to the i-th pin given to the constructor. With the
+ *                chardev backend all lines of a chip are changed by a
+ *                single GPIO_V2_LINE_SET_VALUES call. The sysfs backend
+ *                writes the pins one by one, mmap is not supported.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef GPIO_PORT_H_
+#define GPIO_PORT_H_
+
+#include "gpio.h"
+
+#include <vector>
+#include <memory>
+#include <initializer_list>
+
+namespace bbb
+{
+
+    class gpio_port
+    {
+    public:
+        gpio_port(std::initializer_list<uint16_t> numbers, bbb::direction dir,
+                  bbb::backend be = bbb::backend::chardev);
+        gpio_port(const gpio_port &) = delete;
+        gpio_port &operator=(const gpio_port &) = delete;
+
+        int set_direction(bbb::direction dir);
+
+        int set(uint32_t mask, uint32_t values);
+        int set(uint32_t values) { return set(all(), values); }
+        int get(uint32_t &values, uint32_t mask = ~0u);
+
+        uint32_t all() const;
+        std::size_t size() const { return m_size; }
+
+        ~gpio_port();
+
+    private:
+        struct chip_lines // lines of the port living on the same gpiochip
+        {
+            uint16_t chip;
+            int chip_fd{-1};
+            int line_fd{-1};
+            std::vector<uint32_t> offsets;
+            std::vector<uint8_t> bits; // port bit of each requested line
+        };
+
+        void release();
+
+        constexpr static const std::size_t max_lines = 32;
+
+        std::size_t m_size;
+        bbb::backend m_backend;
+
+        std::vector<chip_lines> m_chips;              // chardev
+        std::vector<std::unique_ptr<bbb::gpio>> m_pins; // sysfs
+    };
+}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ *  Description : gpio_port on a fake sysfs tree in a temporary directory.
+ *                Values are set and read back through the port, a pin
+ *                without a value file must fail the call, and the mmap
+ *                backend must be refused.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "gpio_port.h"
+#include "sysfs_root.h"
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+#include <cstdlib>
+
+static int failures{0};
+
+static void check(const char *what, bool ok)
+{
+    if (!ok)
+    {
+        std::cerr << what << " : failed\n";
+        failures++;
+    }
+}
+
+/* Exported gpio60, gpio48 and gpio49, gpio49 has no value file. */
+static std::string make_tree()
+{
+    char dir[] = "/tmp/bbb_port_XXXXXX";
+    if (!mkdtemp(dir))
+        return {};
+
+    std::string root{dir};
+    std::string gpio{root + "/sys/class/gpio/"};
+    for (auto n : {"gpio60", "gpio48", "gpio49"})
+    {
+        std::filesystem::create_directories(gpio + n);
+        std::ofstream{gpio + n + "/direction"} << "in\n";
+        std::ofstream{gpio + n + "/active_low"} << "0\n";
+    }
+    std::ofstream{gpio + "export"};
+    std::ofstream{gpio + "unexport"};
+    std::ofstream{gpio + "gpio60/value"} << "0\n";
+    std::ofstream{gpio + "gpio48/value"} << "0\n";
+
+    return root;
+}
+
+int main()
+{
+    auto root = make_tree();
+    if (root.empty())
+    {
+        std::cerr << "fake sysfs tree cannot be created\n";
+        return 1;
+    }
+    bbb::set_sysfs_root(root);
+
+    {
+        bbb::gpio_port port{{60, 48}, bbb::direction::out, bbb::backend::sysfs};
+        uint32_t values{0};
+
+        check("set", port.set(0b10) == 0);
+        check("get", port.get(values) == 0 && values == 0b10);
+        check("set masked", port.set(0b01, 0b11) == 0);
+        check("get masked", port.get(values, 0b01) == 0 && values == 0b01);
+        check("get all", port.get(values) == 0 && values == 0b11);
+    }
+    {
+        bbb::gpio_port port{{60, 49}, bbb::direction::out, bbb::backend::sysfs};
+        uint32_t values{0};
+
+        check("set on a broken pin", port.set(0b11) == -1);
+        check("get on a broken pin", port.get(values) == -1);
+        check("broken pin masked out", port.get(values, 0b01) == 0);
+    }
+
+    bool refused{false};
+    try
+    {
+        bbb::gpio_port port{{60}, bbb::direction::out, bbb::backend::mmap};
+    }
+    catch (const std::runtime_error &)
+    {
+        refused = true;
+    }
+    check("mmap refused", refused);
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+
+    std::cout << (failures ? "FAILED" : "passed") << '\n';
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+/*
+ *  Description : Motion profiles for pwm outputs (servos, ramps). Targets
+ *                are given as angle or duty with a linear, trapezoidal or
+ *                s-curve profile, and every channel is updated from one
+ *                periodic thread on absolute deadlines.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "motion.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+namespace bbb
+{
+
+    motion::motion(uint32_t update_ns, int priority) : m_update_ns{update_ns}, m_priority{priority}
+    {
+        if (update_ns == 0)
+        {
+            throw std::runtime_error{"invalid motion update period"};
+        }
+    }
+
+    std::size_t motion::add(bbb::pwm &out, uint32_t min_duty, uint32_t max_duty, double max_angle)
+    {
+        if (m_running)
+        {
+            throw std::runtime_error{"motion axes cannot be added while running"};
+        }
+
+        uint32_t duty = out.get_duty_cycle();
+        m_axes.push_back({&out, min_duty, max_duty, max_angle, duty, duty, duty});
+        m_pending.reserve(m_axes.size());
+
+        return m_axes.size() - 1;
+    }
+
+    /* Normalized position of a profile, t and the result are in [0, 1]. */
+    double motion::position(bbb::profile prof, double t)
+    {
+        t = std::clamp(t, 0., 1.);
+
+        switch (prof)
+        {
+        case bbb::profile::trapezoidal:
+        {
+            constexpr double ta = 0.25;
+            constexpr double v = 1 / (1 - ta); // cruise speed covering the unit distance
+
+            if (t < ta)
+                return 0.5 * v / ta * t * t;
+            if (t < 1 - ta)
+                return 0.5 * v * ta + v * (t - ta);
+            return 1 - 0.5 * v / ta * (1 - t) * (1 - t);
+        }
+        case bbb::profile::s_curve:
+            return t * t * t * (10 + t * (-15 + t * 6));
+        default:
+            return t;
+        }
+    }
+
+    /* Where an axis is at a time, it is also the start of a new move. */
+    static uint32_t duty_at(uint32_t from, uint32_t to, double s)
+    {
+        return from + static_cast<int64_t>((static_cast<int64_t>(to) - from) * s);
+    }
+
+    int motion::move_to_duty(std::size_t ch, uint32_t duty, std::chrono::milliseconds time, bbb::profile prof)
+    {
+        if (ch >= m_axes.size())
+            return -1;
+
+        std::lock_guard<std::mutex> lock{m_mtx};
+        auto &a = m_axes[ch];
+
+        if (duty < std::min(a.min_duty, a.max_duty) || std::max(a.min_duty, a.max_duty) < duty)
+            return -1;
+
+        uint64_t now = rt::now_ns();
+        if (a.length)
+            a.from = duty_at(a.from, a.to, position(a.prof, double(now - a.t0) / a.length));
+        else
+            a.from = a.written;
+
+        a.to = duty;
+        a.t0 = now;
+        a.length = std::max<uint64_t>(std::chrono::nanoseconds{time}.count(), 1);
+        a.prof = prof;
+
+        return 0;
+    }
+
+    int motion::move_to_angle(std::size_t ch, double angle, std::chrono::milliseconds time, bbb::profile prof)
+    {
+        if (ch >= m_axes.size())
+            return -1;
+
+        const auto &a = m_axes[ch];
+        if (angle < 0 || a.max_angle < angle)
+            return -1;
+
+        uint32_t duty = duty_at(a.min_duty, a.max_duty, angle / a.max_angle);
+
+        return move_to_duty(ch, duty, time, prof);
+    }
+
+    bool motion::busy(std::size_t ch)
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+        return ch < m_axes.size() && m_axes[ch].length;
+    }
+
+    void motion::wait_idle()
+    {
+        std::unique_lock<std::mutex> lock{m_mtx};
+        m_idle.wait(lock, [this]
+                    { return !m_running || std::none_of(m_axes.begin(), m_axes.end(),
+                                                        [](const axis &a) { return a.length; }); });
+    }
+
+    int motion::start()
+    {
+        if (m_running || m_axes.empty())
+            return -1;
+
+        m_running = true;
+        m_thread = std::thread{&motion::run, this};
+
+        return 0;
+    }
+
+    void motion::stop()
+    {
+        m_running = false;
+        if (m_thread.joinable())
+            m_thread.join();
+
+        m_idle.notify_all();
+    }
+
+    bbb::rt::lateness motion::lateness()
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+        return m_lateness;
+    }
+
+    void motion::run()
+    {
+        if (rt::set_fifo(m_priority) == -1)
+            std::cerr << "motion : SCHED_FIFO cannot be set\n";
+
+        uint64_t deadline = rt::now_ns() + m_update_ns;
+
+        while (m_running)
+        {
+            rt::sleep_until(deadline);
+            uint64_t now = rt::now_ns();
+
+            if (now > deadline + m_update_ns)
+            {
+                // skipped whole updates, continue from now instead of catching up
+                m_missed += (now - deadline) / m_update_ns;
+                deadline = now;
+            }
+
+            bool idle{true};
+            {
+                std::lock_guard<std::mutex> lock{m_mtx};
+                m_lateness.add(now > deadline ? now - deadline : 0);
+
+                for (auto &a : m_axes)
+                {
+                    if (!a.length)
+                        continue;
+
+                    double t = double(now - a.t0) / a.length;
+                    uint32_t duty = t >= 1 ? a.to : duty_at(a.from, a.to, position(a.prof, t));
+
+                    if (duty != a.written)
+                    {
+                        m_pending.emplace_back(a.out, duty);
+                        a.written = duty;
+                    }
+                    if (t >= 1)
+                        a.length = 0;
+                    else
+                        idle = false;
+                }
+            }
+
+            for (auto &[out, duty] : m_pending)
+                out->set_duty_cycle(duty);
+            m_pending.clear();
+
+            if (idle)
+                m_idle.notify_all();
+
+            deadline += m_update_ns;
+        }
+    }
+
+    motion::~motion()
+    {
+        stop();
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ *  Description : Motion profiles for pwm outputs (servos, ramps). Targets
+ *                are given as angle or duty with a linear, trapezoidal or
+ *                s-curve profile, and every channel is updated from one
+ *                periodic thread on absolute deadlines.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef MOTION_H_
+#define MOTION_H_
+
+#include "pwm.h"
+#include "rt_thread.h"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+
+namespace bbb
+{
+    enum class profile
+    {
+        linear,
+        trapezoidal, // a quarter of the time accelerating, a quarter decelerating
+        s_curve      // minimum jerk, 10t^3 - 15t^4 + 6t^5
+    };
+
+    class motion
+    {
+    public:
+        explicit motion(uint32_t update_ns = 20'000'000u, int priority = 0);
+        motion(const motion &) = delete;
+        motion &operator=(const motion &) = delete;
+
+        // duty range of the output, min_duty at angle 0 and max_duty at max_angle
+        std::size_t add(bbb::pwm &out, uint32_t min_duty, uint32_t max_duty, double max_angle = 180.);
+
+        int move_to_duty(std::size_t ch, uint32_t duty, std::chrono::milliseconds time,
+                         bbb::profile prof = bbb::profile::s_curve);
+        int move_to_angle(std::size_t ch, double angle, std::chrono::milliseconds time,
+                          bbb::profile prof = bbb::profile::s_curve);
+
+        bool busy(std::size_t ch);
+        void wait_idle();
+
+        int start();
+        void stop();
+
+        uint64_t missed_deadlines() const { return m_missed; }
+        bbb::rt::lateness lateness();
+
+        static double position(bbb::profile prof, double t);
+
+        ~motion();
+
+    private:
+        struct axis
+        {
+            bbb::pwm *out;
+            uint32_t min_duty;
+            uint32_t max_duty;
+            double max_angle;
+
+            uint32_t from;
+            uint32_t to;
+            uint32_t written;
+            uint64_t t0{0};     // ns
+            uint64_t length{0}; // ns, 0 -> idle
+            bbb::profile prof{bbb::profile::linear};
+        };
+
+        void run();
+
+        uint32_t m_update_ns;
+        int m_priority;
+
+        std::vector<axis> m_axes;
+        std::vector<std::pair<bbb::pwm *, uint32_t>> m_pending; // owned by the thread
+
+        std::mutex m_mtx;
+        std::condition_variable m_idle;
+        std::thread m_thread;
+        std::atomic<bool> m_running{false};
+        std::atomic<uint64_t> m_missed{0};
+        bbb::rt::lateness m_lateness;
+    };
+}
+
+#endif
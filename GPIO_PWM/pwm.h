@@ -1,6 +1,7 @@
 /*
- *  Description : Simple PWM interface. It can be used only beaglebone
- *                black P9_14, P9_16, P9_21 and P9_22 pins for now.
+ *  Description : Simple PWM interface for the beaglebone black ehrpwm and
+ *                ecap outputs listed in pwm_pins.h. The attribute files are
+ *                kept open and the period is cached.
  *  License     : MIT License
  *  Created on  : 2025
  *  Author      : Heval Aktaş
@@ -12,16 +13,13 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include "pwm_pins.h"
 
 namespace bbb
 {
 
     class pwm
     {
-        constexpr static const char *state_path = "/sys/devices/platform/ocp/ocp:P9_"; // used only for exporting
-
-        std::string pwm_path{"/dev/bone/pwm/"};
-
         constexpr static const char period[] = "/period";
         constexpr static const char enable[] = "/enable";
         constexpr static const char polarity[] = "/polarity";
@@ -33,13 +31,28 @@ namespace bbb
             constexpr static const char inversed[]{"inversed"};
         };
 
-        std::fstream m_file;
+        std::fstream m_file; // only for the pinmux state
+
+        int m_period_fd{-1};
+        int m_duty_fd{-1};
+        int m_enable_fd{-1};
+        int m_polarity_fd{-1};
+
+        uint32_t m_period{0}; // cached, updated by set_period
 
-        int write(const char *filename, std::string value);
-        std::string read(const char *filename);
+        const pwm_pin_info &m_pin;
+
+        int open_attr(const std::string &path, const char *filename);
+        int write(int fd, const char *filename, uint32_t value);
+        int write(int fd, const char *filename, const char *value);
+        std::string read(int fd, const char *filename);
 
     public:
-        explicit pwm(uint16_t pin);
+        explicit pwm(uint16_t pin); // P9 header pin number
+        explicit pwm(const pwm_pin_info &pin);
+
+        template <bbb::header H, uint8_t N>
+        explicit pwm(bbb::pwm_pin<H, N>) : pwm{bbb::pwm_pin<H, N>::info()} {}
 
         pwm(const pwm &) = delete;
         pwm &operator=(const pwm &) = delete;
@@ -53,10 +66,17 @@ namespace bbb
 
         int set_enable();
         int set_disable();
+        int get_enable();
 
         int set_normal_polarity();
         int set_inversed_polarity();
         std::string get_polarity();
+
+        uint8_t module() const { return m_pin.module; } // channels of a module share the period
+        char channel() const { return m_pin.channel; }
+        const pwm_pin_info &pin() const { return m_pin; }
+
+        ~pwm();
     };
 }
 
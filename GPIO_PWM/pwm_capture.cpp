@@ -0,0 +1,203 @@
+/*
+ *  Description : PWM input capture for tachometer and RC receiver pulses.
+ *                Edges come from the timestamped events of a bbb::gpio
+ *                input or are fed directly, and frequency, period and duty
+ *                are kept over a sliding window of the last periods with
+ *                running sums, so an edge costs O(1) and never allocates.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "pwm_capture.h"
+#include "rt_thread.h"
+
+#include <iostream>
+#include <stdexcept>
+
+namespace bbb
+{
+
+    pwm_capture::pwm_capture(std::size_t window) : m_window(window)
+    {
+        if (window == 0)
+        {
+            throw std::runtime_error{"invalid pwm capture window"};
+        }
+    }
+
+    pwm_capture::pwm_capture(bbb::gpio &input, std::size_t window, uint32_t debounce_us) : pwm_capture{window}
+    {
+        if (input.set_edge(bbb::edge::both, debounce_us) == -1)
+        {
+            throw std::runtime_error{"pwm capture input edges cannot be enabled"};
+        }
+        m_input = &input;
+    }
+
+    /*
+        A period is closed by a rising edge that follows a rising and a
+        falling edge. Any other order means an edge was lost or bounced,
+        the partial period is dropped and measuring restarts at this edge.
+    */
+    void pwm_capture::add_edge(uint64_t timestamp_ns, bool rising)
+    {
+        m_edges.fetch_add(1, std::memory_order_relaxed);
+
+        if (m_last && timestamp_ns <= m_last)
+        {
+            m_glitches.fetch_add(1, std::memory_order_relaxed);
+            m_rise = m_fall = 0;
+        }
+        m_last = timestamp_ns;
+
+        if (!rising)
+        {
+            if (m_rise && !m_fall)
+            {
+                m_fall = timestamp_ns;
+            }
+            else if (m_rise)
+            {
+                m_glitches.fetch_add(1, std::memory_order_relaxed);
+                m_rise = 0;
+            }
+            return;
+        }
+
+        if (m_rise && m_fall)
+        {
+            auto &s = m_window[m_head];
+            if (m_count == m_window.size())
+            {
+                m_sum_period -= s.period;
+                m_sum_high -= s.high;
+            }
+            else
+            {
+                m_count++;
+            }
+
+            s = {timestamp_ns - m_rise, m_fall - m_rise};
+            m_sum_period += s.period;
+            m_sum_high += s.high;
+
+            if (++m_head == m_window.size())
+                m_head = 0;
+        }
+        else if (m_rise)
+        {
+            m_glitches.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_rise = timestamp_ns;
+        m_fall = 0;
+    }
+
+    void pwm_capture::edge(uint64_t timestamp_ns, bool rising)
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+        add_edge(timestamp_ns, rising);
+    }
+
+    void pwm_capture::edge(const bbb::gpio_event &ev)
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+
+        if (m_seqno && ev.seqno != m_seqno + 1) // the kernel or the ring dropped events
+        {
+            m_glitches.fetch_add(1, std::memory_order_relaxed);
+            m_rise = m_fall = 0;
+        }
+        m_seqno = ev.seqno;
+
+        add_edge(ev.timestamp_ns, ev.type == bbb::edge::rising);
+    }
+
+    int pwm_capture::poll(int timeout_ms)
+    {
+        if (!m_input)
+            return -1;
+
+        bbb::gpio_event ev;
+        int ret = m_input->wait_event(ev, timeout_ms);
+        if (ret != 1)
+            return ret;
+
+        int n{0};
+        do
+        {
+            edge(ev);
+            n++;
+        } while (m_input->pop_event(ev));
+
+        return n;
+    }
+
+    int pwm_capture::start(int priority)
+    {
+        if (!m_input || m_running)
+            return -1;
+
+        m_priority = priority;
+        m_running = true;
+        m_thread = std::thread{&pwm_capture::run, this};
+
+        return 0;
+    }
+
+    void pwm_capture::stop()
+    {
+        m_running = false;
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    void pwm_capture::run()
+    {
+        if (rt::set_fifo(m_priority) == -1)
+            std::cerr << "pwm_capture : SCHED_FIFO cannot be set\n";
+
+        while (m_running)
+        {
+            if (poll(100) == -1) // wakes up to see stop()
+            {
+                std::cerr << "pwm_capture : input events cannot be read\n";
+                break;
+            }
+        }
+    }
+
+    bbb::pwm_measurement pwm_capture::read()
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+
+        bbb::pwm_measurement m;
+        m.periods = m_count;
+        m.last_edge_ns = m_last;
+
+        if (m_count && m_sum_period)
+        {
+            m.period_ns = double(m_sum_period) / m_count;
+            m.frequency_hz = 1e9 / m.period_ns;
+            m.duty = double(m_sum_high) / m_sum_period;
+        }
+
+        return m;
+    }
+
+    void pwm_capture::clear()
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+
+        m_head = m_count = 0;
+        m_sum_period = m_sum_high = 0;
+        m_rise = m_fall = m_last = 0;
+        m_seqno = 0;
+    }
+
+    pwm_capture::~pwm_capture()
+    {
+        stop();
+    }
+}
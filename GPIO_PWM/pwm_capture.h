@@ -0,0 +1,89 @@
+/*
+ *  Description : PWM input capture for tachometer and RC receiver pulses.
+ *                Edges come from the timestamped events of a bbb::gpio
+ *                input or are fed directly, and frequency, period and duty
+ *                are kept over a sliding window of the last periods with
+ *                running sums, so an edge costs O(1) and never allocates.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef PWM_CAPTURE_H_
+#define PWM_CAPTURE_H_
+
+#include "gpio.h"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+
+namespace bbb
+{
+    struct pwm_measurement
+    {
+        double frequency_hz{0};
+        double period_ns{0};
+        double duty{0};         // high time over period, 0 - 1
+        std::size_t periods{0}; // complete periods in the window
+        uint64_t last_edge_ns{0};
+    };
+
+    class pwm_capture
+    {
+    public:
+        explicit pwm_capture(std::size_t window = 16); // edges fed with edge()
+        pwm_capture(bbb::gpio &input, std::size_t window = 16, uint32_t debounce_us = 0);
+        pwm_capture(const pwm_capture &) = delete;
+        pwm_capture &operator=(const pwm_capture &) = delete;
+
+        void edge(uint64_t timestamp_ns, bool rising);
+        void edge(const bbb::gpio_event &ev);
+
+        int poll(int timeout_ms = -1); // feeds pending gpio events, number of edges or -1
+
+        int start(int priority = 0); // polls the input from a thread
+        void stop();
+
+        bbb::pwm_measurement read();
+        void clear();
+
+        uint64_t edges() const { return m_edges; }
+        uint64_t glitches() const { return m_glitches; } // edges out of order or lost
+
+        ~pwm_capture();
+
+    private:
+        struct sample
+        {
+            uint64_t period; // ns, rising to rising
+            uint64_t high;   // ns, rising to falling
+        };
+
+        void add_edge(uint64_t timestamp_ns, bool rising);
+        void run();
+
+        bbb::gpio *m_input{nullptr};
+
+        std::vector<sample> m_window; // allocated once
+        std::size_t m_head{0};        // next slot to write
+        std::size_t m_count{0};
+        uint64_t m_sum_period{0};
+        uint64_t m_sum_high{0};
+
+        uint64_t m_rise{0}; // last rising edge, 0 before the first
+        uint64_t m_fall{0}; // falling edge after m_rise, 0 if not seen yet
+        uint64_t m_last{0};
+        uint32_t m_seqno{0};
+
+        std::mutex m_mtx;
+        std::thread m_thread;
+        std::atomic<bool> m_running{false};
+        std::atomic<uint64_t> m_edges{0};
+        std::atomic<uint64_t> m_glitches{0};
+        int m_priority{0};
+    };
+}
+
+#endif
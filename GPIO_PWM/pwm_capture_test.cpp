@@ -0,0 +1,74 @@
+/*
+ *  Description : PWM capture test. Without arguments a synthetic 5 kHz,
+ *                30 % duty edge stream with timing noise is fed and the
+ *                cost of an edge is printed. With a gpio number the input
+ *                is measured once a second through chardev edge events.
+ *                usage : pwm_capture_test          (synthetic edges)
+ *                        pwm_capture_test 60       (P9_12 input)
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "pwm_capture.h"
+#include "rt_thread.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <random>
+
+static void print(const bbb::pwm_measurement &m)
+{
+    std::cout << "frequency : " << m.frequency_hz << " Hz, period : " << m.period_ns / 1000.
+              << " us, duty : " << m.duty * 100 << " % over " << m.periods << " periods\n";
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace std::literals;
+
+    if (argc > 1)
+    {
+        bbb::gpio input{static_cast<uint16_t>(std::atoi(argv[1])), bbb::direction::in, bbb::backend::chardev};
+        bbb::pwm_capture cap{input, 64};
+
+        cap.start(50);
+        for (int i{0}; i < 10; i++)
+        {
+            std::this_thread::sleep_for(1s);
+            print(cap.read());
+        }
+        cap.stop();
+
+        std::cout << "edges : " << cap.edges() << ", glitches : " << cap.glitches() << '\n';
+        return 0;
+    }
+
+    bbb::pwm_capture cap{64};
+
+    std::mt19937 gen{1};
+    std::normal_distribution<double> noise{0., 500.}; // ns
+
+    constexpr uint64_t period = 200'000; // 5 kHz
+    constexpr uint64_t high = 60'000;    // 30 %
+    constexpr int periods = 1'000'000;
+
+    std::vector<uint64_t> times;
+    times.reserve(2 * periods);
+    for (uint64_t i{0}; i < periods; i++)
+    {
+        times.push_back(1'000'000 + i * period + static_cast<int64_t>(noise(gen)));
+        times.push_back(1'000'000 + i * period + high + static_cast<int64_t>(noise(gen)));
+    }
+
+    uint64_t start = bbb::rt::now_ns();
+    for (std::size_t i{0}; i < times.size(); i++)
+        cap.edge(times[i], !(i & 1));
+    uint64_t elapsed = bbb::rt::now_ns() - start;
+
+    print(cap.read());
+    std::cout << "edges : " << cap.edges() << ", glitches : " << cap.glitches()
+              << ", " << double(elapsed) / times.size() << " ns per edge\n";
+
+    return 0;
+}
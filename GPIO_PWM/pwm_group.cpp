@@ -0,0 +1,224 @@
+/*
+ *  Description : Coordinated updates of the channels of one or more ehrpwm
+ *                modules. Channels a and b of a module share the period
+ *                register, so a batch is validated against that constraint
+ *                and written in an order the driver accepts : disables,
+ *                duty/period in the order that keeps duty <= period, then
+ *                enables. Values already applied are not written again.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "pwm_group.h"
+
+#include "sysfs_root.h"
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+
+namespace bbb
+{
+
+    pwm_group::pwm_group(std::vector<bbb::pwm *> channels) : m_channels{std::move(channels)}
+    {
+        for (auto *ch : m_channels)
+        {
+            m_state.push_back({static_cast<uint32_t>(ch->get_period()),
+                               static_cast<uint32_t>(ch->get_duty_cycle()),
+                               ch->get_enable() == 1});
+        }
+
+        for (std::size_t i{0}; i < m_channels.size(); i++)
+        {
+            for (std::size_t j{i + 1}; j < m_channels.size(); j++)
+            {
+                if (m_channels[i]->module() == m_channels[j]->module() &&
+                    m_channels[i]->channel() == m_channels[j]->channel())
+                {
+                    throw std::runtime_error{"pwm channel added twice to pwm_group"};
+                }
+            }
+        }
+    }
+
+    /*
+        Period of the other channel of an ehrpwm module, 0 when it is not
+        configured or the module has a single channel (ecap).
+    */
+    uint32_t pwm_group::sibling_period(std::size_t i) const
+    {
+        const auto &pin = m_channels[i]->pin();
+        if (pin.module >= ecap_module)
+            return 0;
+
+        for (std::size_t j{0}; j < m_channels.size(); j++)
+        {
+            if (m_channels[j]->module() == pin.module && m_channels[j]->channel() != pin.channel)
+                return m_state[j].period;
+        }
+
+        for (const auto &other : pwm_pins)
+        {
+            if (other.module == pin.module && other.channel != pin.channel)
+            {
+                std::ifstream file{sysfs_root() + other.path + "/period"};
+                uint32_t per{0};
+                file >> per;
+                return per;
+            }
+        }
+        return 0;
+    }
+
+    int pwm_group::write_period(std::size_t i, uint32_t per)
+    {
+        if (m_channels[i]->set_period(per) == -1)
+            return -1;
+
+        m_state[i].period = per;
+        m_writes++;
+        return 0;
+    }
+
+    int pwm_group::write_duty(std::size_t i, uint32_t duty)
+    {
+        if (m_channels[i]->set_duty_cycle(duty) == -1)
+            return -1;
+
+        m_state[i].duty = duty;
+        m_writes++;
+        return 0;
+    }
+
+    int pwm_group::write_enable(std::size_t i, bool en)
+    {
+        if ((en ? m_channels[i]->set_enable() : m_channels[i]->set_disable()) == -1)
+            return -1;
+
+        m_state[i].enabled = en;
+        m_writes++;
+        return 0;
+    }
+
+    /*
+        The period of a module is applied to all of its channels in the group.
+        Conflicting periods for one module or a duty above its period reject
+        the whole batch before anything is written. The ehrpwm driver refuses
+        a period that differs from the one of an already configured sibling
+        channel, in any order and even while disabled, so the period of a
+        module can only change while one of its channels is configured. Such
+        a batch is rejected up front as well. If a write still fails, the
+        batch stops there; the get_ functions and writes() tell what was
+        applied.
+    */
+    int pwm_group::apply(const std::vector<change> &batch)
+    {
+        uint64_t start = rt::now_ns();
+        m_writes = 0;
+
+        auto target = m_state;
+        for (const auto &c : batch)
+        {
+            if (c.channel >= m_channels.size())
+                return -1;
+
+            if (c.duty)
+                target[c.channel].duty = *c.duty;
+            if (c.enable)
+                target[c.channel].enabled = *c.enable;
+        }
+
+        for (const auto &c : batch)
+        {
+            if (!c.period)
+                continue;
+
+            for (std::size_t j{0}; j < m_channels.size(); j++)
+            {
+                if (m_channels[j]->module() != m_channels[c.channel]->module())
+                    continue;
+
+                for (const auto &other : batch)
+                {
+                    if (other.period && other.channel == j && *other.period != *c.period)
+                    {
+                        std::cerr << "pwm_group : conflicting periods for pwm module " << +m_channels[j]->module() << '\n';
+                        return -1;
+                    }
+                }
+                target[j].period = *c.period;
+            }
+        }
+
+        for (const auto &t : target)
+        {
+            if (t.duty > t.period)
+            {
+                std::cerr << "pwm_group : duty cycle is longer than the period\n";
+                return -1;
+            }
+        }
+
+        const auto n = m_channels.size();
+
+        for (std::size_t i{0}; i < n; i++)
+        {
+            if (target[i].period == m_state[i].period)
+                continue;
+
+            uint32_t sibling = sibling_period(i);
+            if (sibling && sibling != target[i].period)
+            {
+                std::cerr << "pwm_group : the period of pwm module " << +m_channels[i]->module()
+                          << " cannot change while both of its channels are configured\n";
+                return -1;
+            }
+        }
+
+        if (write_batch(target) == -1)
+        {
+            std::cerr << "pwm_group : batch stopped after " << m_writes << " writes, it is partially applied\n";
+            return -1;
+        }
+
+        m_latency.add(rt::now_ns() - start);
+
+        return 0;
+    }
+
+    /* Disables, shrinking duties, periods, growing duties, enables. */
+    int pwm_group::write_batch(const std::vector<state> &target)
+    {
+        const auto n = m_channels.size();
+
+        for (std::size_t i{0}; i < n; i++) // disables first
+        {
+            if (!target[i].enabled && m_state[i].enabled && write_enable(i, false) == -1)
+                return -1;
+        }
+        for (std::size_t i{0}; i < n; i++) // shrinking duties fit the old period
+        {
+            if (target[i].duty < m_state[i].duty && write_duty(i, target[i].duty) == -1)
+                return -1;
+        }
+        for (std::size_t i{0}; i < n; i++) // every current duty fits the new period
+        {
+            if (target[i].period != m_state[i].period && write_period(i, target[i].period) == -1)
+                return -1;
+        }
+        for (std::size_t i{0}; i < n; i++) // growing duties fit the new period
+        {
+            if (target[i].duty > m_state[i].duty && write_duty(i, target[i].duty) == -1)
+                return -1;
+        }
+        for (std::size_t i{0}; i < n; i++) // enables last
+        {
+            if (target[i].enabled && !m_state[i].enabled && write_enable(i, true) == -1)
+                return -1;
+        }
+
+        return 0;
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ *  Description : Coordinated updates of the channels of one or more ehrpwm
+ *                modules. Channels a and b of a module share the period
+ *                register, so a batch is validated against that constraint
+ *                and written in an order the driver accepts : disables,
+ *                duty/period in the order that keeps duty <= period, then
+ *                enables. Values already applied are not written again.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef PWM_GROUP_H_
+#define PWM_GROUP_H_
+
+#include "pwm.h"
+#include "rt_thread.h"
+
+#include <vector>
+#include <optional>
+
+namespace bbb
+{
+
+    class pwm_group
+    {
+    public:
+        struct change
+        {
+            std::size_t channel; // index in the group
+            std::optional<uint32_t> period;
+            std::optional<uint32_t> duty;
+            std::optional<bool> enable;
+        };
+
+        explicit pwm_group(std::vector<bbb::pwm *> channels);
+        pwm_group(const pwm_group &) = delete;
+        pwm_group &operator=(const pwm_group &) = delete;
+
+        int apply(const std::vector<change> &batch);
+
+        uint32_t get_period(std::size_t channel) const { return m_state[channel].period; }
+        uint32_t get_duty_cycle(std::size_t channel) const { return m_state[channel].duty; }
+        bool get_enable(std::size_t channel) const { return m_state[channel].enabled; }
+
+        uint32_t writes() const { return m_writes; } // of the last batch
+        const bbb::rt::lateness &latency() const { return m_latency; }
+        void clear_latency() { m_latency.clear(); }
+
+    private:
+        struct state
+        {
+            uint32_t period;
+            uint32_t duty;
+            bool enabled;
+        };
+
+        uint32_t sibling_period(std::size_t i) const;
+        int write_batch(const std::vector<state> &target);
+        int write_period(std::size_t i, uint32_t per);
+        int write_duty(std::size_t i, uint32_t duty);
+        int write_enable(std::size_t i, bool en);
+
+        std::vector<bbb::pwm *> m_channels;
+        std::vector<state> m_state; // what the hardware has
+
+        uint32_t m_writes{0};
+        bbb::rt::lateness m_latency;
+    };
+}
+
+#endif
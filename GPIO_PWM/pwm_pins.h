@@ -0,0 +1,77 @@
+/*
+ *  Description : Compile-time map of the beaglebone black header pins with
+ *                a pwm output (ehrpwm and ecap). pwm_pin<header, N> fails to
+ *                compile for a pin without one. The paths are literals, so
+ *                no string is built per pin at runtime.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef PWM_PINS_H_
+#define PWM_PINS_H_
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace bbb
+{
+    enum class header : uint8_t
+    {
+        P8 = 8,
+        P9 = 9
+    };
+
+    struct pwm_pin_info
+    {
+        bbb::header hdr;
+        uint8_t pin;
+        uint8_t module;    // ehrpwm n -> n, ecap n -> ecap_module + n
+        char channel;      // 'a', 'b' or 'e' for ecap
+        const char *path;  // udev link of the pwm channel
+        const char *state; // pinmux helper state file
+    };
+
+    constexpr static const uint8_t ecap_module = 16;
+
+    constexpr static const pwm_pin_info pwm_pins[] = {
+        {header::P8, 13, 2, 'b', "/dev/bone/pwm/2/b", "/sys/devices/platform/ocp/ocp:P8_13_pinmux/state"},
+        {header::P8, 19, 2, 'a', "/dev/bone/pwm/2/a", "/sys/devices/platform/ocp/ocp:P8_19_pinmux/state"},
+        {header::P8, 34, 1, 'b', "/dev/bone/pwm/1/b", "/sys/devices/platform/ocp/ocp:P8_34_pinmux/state"},
+        {header::P8, 36, 1, 'a', "/dev/bone/pwm/1/a", "/sys/devices/platform/ocp/ocp:P8_36_pinmux/state"},
+        {header::P8, 45, 2, 'a', "/dev/bone/pwm/2/a", "/sys/devices/platform/ocp/ocp:P8_45_pinmux/state"},
+        {header::P8, 46, 2, 'b', "/dev/bone/pwm/2/b", "/sys/devices/platform/ocp/ocp:P8_46_pinmux/state"},
+        {header::P9, 14, 1, 'a', "/dev/bone/pwm/1/a", "/sys/devices/platform/ocp/ocp:P9_14_pinmux/state"},
+        {header::P9, 16, 1, 'b', "/dev/bone/pwm/1/b", "/sys/devices/platform/ocp/ocp:P9_16_pinmux/state"},
+        {header::P9, 21, 0, 'b', "/dev/bone/pwm/0/b", "/sys/devices/platform/ocp/ocp:P9_21_pinmux/state"},
+        {header::P9, 22, 0, 'a', "/dev/bone/pwm/0/a", "/sys/devices/platform/ocp/ocp:P9_22_pinmux/state"},
+        {header::P9, 28, ecap_module + 2, 'e', "/dev/bone/pwm/ecap2", "/sys/devices/platform/ocp/ocp:P9_28_pinmux/state"},
+        {header::P9, 29, 0, 'b', "/dev/bone/pwm/0/b", "/sys/devices/platform/ocp/ocp:P9_29_pinmux/state"},
+        {header::P9, 31, 0, 'a', "/dev/bone/pwm/0/a", "/sys/devices/platform/ocp/ocp:P9_31_pinmux/state"},
+        {header::P9, 42, ecap_module + 0, 'e', "/dev/bone/pwm/ecap0", "/sys/devices/platform/ocp/ocp:P9_42_pinmux/state"},
+    };
+
+    constexpr static const std::size_t pwm_pin_count = sizeof(pwm_pins) / sizeof(pwm_pins[0]);
+
+    /* Index of a pin in pwm_pins, pwm_pin_count if it has no pwm output. */
+    constexpr std::size_t find_pwm_pin(bbb::header hdr, uint8_t pin)
+    {
+        for (std::size_t i{0}; i < pwm_pin_count; i++)
+        {
+            if (pwm_pins[i].hdr == hdr && pwm_pins[i].pin == pin)
+                return i;
+        }
+        return pwm_pin_count;
+    }
+
+    template <bbb::header H, uint8_t N>
+    struct pwm_pin
+    {
+        constexpr static const std::size_t index = find_pwm_pin(H, N);
+        static_assert(index < pwm_pin_count, "this header pin has no pwm output");
+
+        constexpr static const pwm_pin_info &info() { return pwm_pins[index]; }
+    };
+}
+
+#endif
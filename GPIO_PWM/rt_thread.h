@@ -0,0 +1,107 @@
+/*
+ *  Description : Small helpers for periodic real-time threads : absolute
+ *                CLOCK_MONOTONIC deadlines, SCHED_FIFO, locked memory and
+ *                lateness statistics.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef RT_THREAD_H_
+#define RT_THREAD_H_
+
+#include <stdint.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+namespace bbb
+{
+    namespace rt
+    {
+        inline uint64_t now_ns()
+        {
+            timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return ts.tv_sec * 1'000'000'000ull + ts.tv_nsec;
+        }
+
+        /* Sleep until an absolute CLOCK_MONOTONIC time, so errors do not accumulate. */
+        inline int sleep_until(uint64_t deadline_ns)
+        {
+            timespec ts{static_cast<time_t>(deadline_ns / 1'000'000'000ull),
+                        static_cast<long>(deadline_ns % 1'000'000'000ull)};
+            int ret;
+            while ((ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr)) == EINTR)
+                ;
+            return ret == 0 ? 0 : -1;
+        }
+
+        /* Make the calling thread SCHED_FIFO, priority 0 leaves it unchanged. */
+        inline int set_fifo(int priority)
+        {
+            if (priority <= 0)
+                return 0;
+
+            sched_param param{};
+            param.sched_priority = priority;
+
+            return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0 ? 0 : -1;
+        }
+
+        /* Lock all pages and prefault some stack so the loop does not page fault. */
+        inline int lock_memory()
+        {
+            if (mlockall(MCL_CURRENT | MCL_FUTURE) == -1)
+                return -1;
+
+            volatile char stack[64 * 1024];
+            std::memset(const_cast<char *>(stack), 0, sizeof(stack));
+
+            return 0;
+        }
+
+        struct lateness
+        {
+            constexpr static const int buckets = 16; // bucket 0 : < 2 us, bucket i : [2^i, 2^(i+1)) us
+
+            uint64_t count{0};
+            uint64_t min_ns{~0ull};
+            uint64_t max_ns{0};
+            uint64_t sum_ns{0};
+            uint64_t histogram[buckets]{0};
+
+            void add(uint64_t ns)
+            {
+                count++;
+                sum_ns += ns;
+                min_ns = ns < min_ns ? ns : min_ns;
+                max_ns = ns > max_ns ? ns : max_ns;
+
+                int i{0};
+                for (uint64_t us = ns / 1000; us > 1 && i < buckets - 1; us >>= 1)
+                    i++;
+                histogram[i]++;
+            }
+
+            void merge(const lateness &other)
+            {
+                count += other.count;
+                sum_ns += other.sum_ns;
+                min_ns = other.min_ns < min_ns ? other.min_ns : min_ns;
+                max_ns = other.max_ns > max_ns ? other.max_ns : max_ns;
+                for (int i{0}; i < buckets; i++)
+                    histogram[i] += other.histogram[i];
+            }
+
+            void clear() { *this = lateness{}; }
+
+            uint64_t mean_ns() const { return count ? sum_ns / count : 0; }
+        };
+    }
+}
+
+#endif
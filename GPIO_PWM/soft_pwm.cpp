@@ -0,0 +1,235 @@
+/*
+ *  Description : Software PWM on arbitrary GPIO pins. All channels share
+ *                one period and are driven from a single real-time thread.
+ *                The edges of every channel are sorted into one timeline,
+ *                rebuilt only when a setting changes, so a period costs
+ *                O(edges). Channels offer the bbb::pwm setters.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "soft_pwm.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+namespace bbb
+{
+
+    int soft_pwm::channel::set_duty_cycle(uint32_t duty)
+    {
+        if (duty > m_engine->m_period)
+            return -1;
+
+        st().duty = duty;
+        m_engine->m_generation++;
+
+        return 0;
+    }
+
+    int soft_pwm::channel::set_duty_cycle(double per)
+    {
+        if (per < 0 || 100 < per)
+            return -1;
+
+        return set_duty_cycle(static_cast<uint32_t>(m_engine->m_period * (per / 100.)));
+    }
+
+    int soft_pwm::channel::set_enable()
+    {
+        st().enabled = true;
+        m_engine->m_generation++;
+
+        return 0;
+    }
+
+    int soft_pwm::channel::set_disable()
+    {
+        st().enabled = false;
+        m_engine->m_generation++;
+
+        return 0;
+    }
+
+    int soft_pwm::channel::set_normal_polarity()
+    {
+        st().inversed = false;
+        m_engine->m_generation++;
+
+        return 0;
+    }
+
+    int soft_pwm::channel::set_inversed_polarity()
+    {
+        st().inversed = true;
+        m_engine->m_generation++;
+
+        return 0;
+    }
+
+    soft_pwm::soft_pwm(uint32_t period, int priority, bool lock_memory) : m_period{period},
+                                                                          m_priority{priority},
+                                                                          m_lock_memory{lock_memory}
+    {
+    }
+
+    soft_pwm::channel soft_pwm::add(bbb::gpio &pin)
+    {
+        if (m_running)
+        {
+            throw std::runtime_error{"soft_pwm channels cannot be added while running"};
+        }
+
+        m_channels.push_back(std::make_unique<state>());
+        m_channels.back()->pin = &pin;
+        m_generation++;
+
+        return channel{this, m_channels.size() - 1};
+    }
+
+    int soft_pwm::set_period(uint32_t per)
+    {
+        if (per == 0)
+            return -1;
+
+        m_period = per;
+        m_generation++;
+
+        return 0;
+    }
+
+    int soft_pwm::start()
+    {
+        if (m_running || m_channels.empty())
+            return -1;
+
+        m_timeline.reserve(m_channels.size());
+        m_active.reserve(m_channels.size());
+        m_built = m_generation - 1; // force a rebuild
+
+        m_running = true;
+        m_thread = std::thread{&soft_pwm::run, this};
+
+        return 0;
+    }
+
+    /* The pins are left alone unless the generator was running. */
+    void soft_pwm::stop()
+    {
+        m_running = false;
+        if (!m_thread.joinable())
+            return;
+        m_thread.join();
+
+        for (uint32_t i{0}; i < m_channels.size(); i++)
+            drive(i, false);
+    }
+
+    bbb::rt::lateness soft_pwm::jitter()
+    {
+        std::lock_guard<std::mutex> lock{m_stats_mtx};
+        return m_stats;
+    }
+
+    void soft_pwm::clear_jitter()
+    {
+        std::lock_guard<std::mutex> lock{m_stats_mtx};
+        m_stats.clear();
+    }
+
+    void soft_pwm::drive(uint32_t index, bool active)
+    {
+        auto &ch = *m_channels[index];
+        ch.pin->set_value(active != ch.inversed ? bbb::value::high : bbb::value::low);
+    }
+
+    /*
+        Channels always low or always high are driven once here, only the
+        channels that toggle take part in the per-period timeline.
+    */
+    void soft_pwm::rebuild()
+    {
+        m_built = m_generation;
+        m_built_period = m_period;
+
+        m_timeline.clear();
+        m_active.clear();
+
+        for (uint32_t i{0}; i < m_channels.size(); i++)
+        {
+            auto &ch = *m_channels[i];
+            uint32_t duty = std::min<uint32_t>(ch.duty, m_built_period);
+
+            if (!ch.enabled || duty == 0)
+            {
+                drive(i, false);
+            }
+            else if (duty == m_built_period)
+            {
+                drive(i, true);
+            }
+            else
+            {
+                m_active.push_back(i);
+                m_timeline.push_back({duty, i});
+            }
+        }
+
+        std::sort(m_timeline.begin(), m_timeline.end(),
+                  [](const edge_at &a, const edge_at &b)
+                  { return a.time < b.time; });
+    }
+
+    void soft_pwm::run()
+    {
+        if (rt::set_fifo(m_priority) == -1)
+            std::cerr << "soft_pwm : SCHED_FIFO cannot be set\n";
+        if (m_lock_memory && rt::lock_memory() == -1)
+            std::cerr << "soft_pwm : memory cannot be locked\n";
+
+        bbb::rt::lateness local;
+        uint64_t base = rt::now_ns() + 100'000;
+
+        while (m_running)
+        {
+            if (m_built != m_generation)
+                rebuild();
+
+            rt::sleep_until(base);
+            uint64_t now = rt::now_ns();
+            local.add(now > base ? now - base : 0);
+
+            for (auto i : m_active)
+                drive(i, true);
+
+            for (std::size_t k{0}; k < m_timeline.size();)
+            {
+                uint64_t deadline = base + m_timeline[k].time;
+
+                rt::sleep_until(deadline);
+                now = rt::now_ns();
+                local.add(now > deadline ? now - deadline : 0);
+
+                // edges falling at the same time share one wake up
+                uint32_t time = m_timeline[k].time;
+                for (; k < m_timeline.size() && m_timeline[k].time == time; k++)
+                    drive(m_timeline[k].index, false);
+            }
+
+            base += m_built_period;
+            if (rt::now_ns() > base + m_built_period)
+                base = rt::now_ns(); // overran a whole period, resynchronize
+
+            std::lock_guard<std::mutex> lock{m_stats_mtx};
+            m_stats.merge(local);
+            local.clear();
+        }
+    }
+
+    soft_pwm::~soft_pwm()
+    {
+        stop();
+    }
+}
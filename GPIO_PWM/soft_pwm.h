@@ -0,0 +1,112 @@
+/*
+ *  Description : Software PWM on arbitrary GPIO pins. All channels share
+ *                one period and are driven from a single real-time thread.
+ *                The edges of every channel are sorted into one timeline,
+ *                rebuilt only when a setting changes, so a period costs
+ *                O(edges). Channels offer the bbb::pwm setters.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef SOFT_PWM_H_
+#define SOFT_PWM_H_
+
+#include "gpio.h"
+#include "rt_thread.h"
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+
+namespace bbb
+{
+
+    class soft_pwm
+    {
+        struct state
+        {
+            bbb::gpio *pin;
+            std::atomic<uint32_t> duty{0}; // ns
+            std::atomic<bool> enabled{false};
+            std::atomic<bool> inversed{false};
+        };
+
+        struct edge_at
+        {
+            uint32_t time;     // ns from the start of the period
+            uint32_t index;    // channel
+        };
+
+    public:
+        class channel
+        {
+            soft_pwm *m_engine;
+            std::size_t m_index;
+
+            state &st() { return *m_engine->m_channels[m_index]; }
+
+        public:
+            channel(soft_pwm *engine, std::size_t index) : m_engine{engine}, m_index{index} {}
+
+            int set_period(uint32_t per) { return m_engine->set_period(per); } // shared by all channels
+            int get_period() { return m_engine->get_period(); }
+
+            int set_duty_cycle(double per);
+            int set_duty_cycle(uint32_t duty);
+            int get_duty_cycle() { return st().duty; }
+
+            int set_enable();
+            int set_disable();
+
+            int set_normal_polarity();
+            int set_inversed_polarity();
+            std::string get_polarity() { return st().inversed ? "inversed" : "normal"; }
+        };
+
+        explicit soft_pwm(uint32_t period = 20'000'000u, int priority = 0, bool lock_memory = false);
+        soft_pwm(const soft_pwm &) = delete;
+        soft_pwm &operator=(const soft_pwm &) = delete;
+
+        channel add(bbb::gpio &pin);
+
+        int set_period(uint32_t per);
+        int get_period() { return m_period; }
+
+        int start();
+        void stop();
+
+        bbb::rt::lateness jitter();
+        void clear_jitter();
+
+        ~soft_pwm();
+
+    private:
+        void run();
+        void rebuild();
+        void drive(uint32_t index, bool active);
+
+        std::vector<std::unique_ptr<state>> m_channels;
+        std::atomic<uint32_t> m_period;
+        std::atomic<uint32_t> m_generation{0}; // bumped on every change
+
+        int m_priority;
+        bool m_lock_memory;
+
+        // owned by the thread
+        std::vector<edge_at> m_timeline;
+        std::vector<uint32_t> m_active;
+        uint32_t m_built{~0u};
+        uint32_t m_built_period{0};
+
+        std::thread m_thread;
+        std::atomic<bool> m_running{false};
+
+        std::mutex m_stats_mtx;
+        bbb::rt::lateness m_stats;
+    };
+}
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ *  Description : Software PWM test. Eight channels with different duty
+ *                cycles at 1 kHz, prints the edge jitter after a second.
+ *                usage : soft_pwm_test        (simulation, fake gpio bank)
+ *                        soft_pwm_test hw     (mmap backend, P8_11, P8_12,
+ *                                              P8_14 - P8_18 and P8_26)
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "soft_pwm.h"
+
+#include <iostream>
+#include <memory>
+#include <cstring>
+
+int main(int argc, char *argv[])
+{
+    using namespace std::literals;
+
+    bool hw = argc > 1 && std::strcmp(argv[1], "hw") == 0;
+
+    // P8_11 P8_12 P8_14 P8_15 P8_16 P8_17 P8_18 P8_26, P8_13 is left to ehrpwm2b
+    const uint16_t numbers[] = {45, 44, 26, 47, 46, 27, 65, 61};
+
+    auto bank = hw ? nullptr : bbb::gpio_bank::fake();
+    std::vector<std::unique_ptr<bbb::gpio>> pins;
+    for (auto n : numbers)
+    {
+        if (hw)
+            pins.push_back(std::make_unique<bbb::gpio>(n, bbb::direction::out, bbb::backend::mmap));
+        else
+            pins.push_back(std::make_unique<bbb::gpio>(n, bbb::direction::out, bank));
+    }
+
+    bbb::soft_pwm spwm{1'000'000u, hw ? 80 : 0, hw};
+
+    double duty{5.};
+    for (auto &pin : pins)
+    {
+        auto ch = spwm.add(*pin);
+        ch.set_duty_cycle(duty);
+        ch.set_enable();
+        duty += 12.5;
+    }
+
+    spwm.start();
+    std::this_thread::sleep_for(1s);
+    spwm.stop();
+
+    auto st = spwm.jitter();
+    std::cout << "edges  : " << st.count << '\n'
+              << "jitter : min " << st.min_ns / 1000. << " us, mean "
+              << st.mean_ns() / 1000. << " us, max " << st.max_ns / 1000. << " us\n";
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+/*
+ *  Description : Prefix prepended to every sysfs and /dev/bone path used by
+ *                gpio and pwm. Empty on the board; a benchmark or test can
+ *                point it at a fake tree in a temporary directory.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef SYSFS_ROOT_H_
+#define SYSFS_ROOT_H_
+
+#include <string>
+
+namespace bbb
+{
+    inline std::string &sysfs_root()
+    {
+        static std::string root;
+        return root;
+    }
+
+    /* Must be set before any gpio or pwm object is created. */
+    inline void set_sysfs_root(const std::string &root)
+    {
+        sysfs_root() = root;
+    }
+}
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ *  Description : Deterministic waveform player for software bit-banging.
+ *                A precomputed schedule of (time, pin mask, level) steps is
+ *                played from a dedicated thread on absolute deadlines. Bit i
+ *                of a mask refers to the i-th pin given to the constructor.
+ *                Use the mmap backend for the shortest edges, or pins on
+ *                gpio_bank::fake() to run the player in simulation. The
+ *                pins of a step change together : one SET/CLEARDATAOUT
+ *                pair per bank on mmap, one GPIO_V2_LINE_SET_VALUES per
+ *                chip when the pins are given as a chardev gpio_port.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "waveform.h"
+
+#include <iostream>
+#include <stdexcept>
+
+namespace bbb
+{
+
+    waveform::waveform(std::vector<bbb::gpio *> pins) : m_pins{std::move(pins)}
+    {
+        if (m_pins.empty() || m_pins.size() > 32)
+        {
+            throw std::runtime_error{"invalid number of pins for waveform"};
+        }
+    }
+
+    waveform::waveform(bbb::gpio_port &port) : m_port{&port}
+    {
+        if (port.size() == 0)
+        {
+            throw std::runtime_error{"invalid number of pins for waveform"};
+        }
+    }
+
+    int waveform::start(std::vector<bbb::wave_step> steps, const options &opt)
+    {
+        if (m_running || m_thread.joinable())
+        {
+            return -1;
+        }
+
+        for (std::size_t i{1}; i < steps.size(); i++)
+        {
+            if (steps[i].time_ns < steps[i - 1].time_ns)
+            {
+                std::cerr << "waveform : steps must be sorted by time\n";
+                return -1;
+            }
+        }
+
+        // the level of the last step lasts until the next repeat starts
+        uint64_t last = steps.empty() ? 0 : steps.back().time_ns;
+        if (opt.repeat > 1 && opt.period_ns <= last)
+        {
+            std::cerr << "waveform : the period of repeats must be longer than the schedule\n";
+            return -1;
+        }
+
+        m_steps = std::move(steps);
+        m_opt = opt;
+        compile();
+        m_stats.clear();
+        m_status = 0;
+        m_stop = false;
+        m_running = true;
+        m_base = rt::now_ns() + m_opt.lead_ns;
+
+        m_thread = std::thread{&waveform::run, this};
+
+        return 0;
+    }
+
+    int waveform::wait()
+    {
+        if (m_thread.joinable())
+            m_thread.join();
+
+        return m_status;
+    }
+
+    int waveform::play(std::vector<bbb::wave_step> steps, const options &opt)
+    {
+        if (start(std::move(steps), opt) == -1)
+            return -1;
+
+        return wait();
+    }
+
+    void waveform::stop()
+    {
+        m_stop = true;
+        wait();
+    }
+
+    /* With every pin on mmap, each step becomes one set/clear pair per bank. */
+    void waveform::compile()
+    {
+        m_writes.clear();
+        m_first.clear();
+
+        if (m_port)
+            return;
+
+        m_fake_banks = m_pins[0]->get_fake_bank() != nullptr;
+        for (auto *pin : m_pins)
+        {
+            if (pin->get_backend() != bbb::backend::mmap || (pin->get_fake_bank() != nullptr) != m_fake_banks)
+                return;
+        }
+
+        for (const auto &step : m_steps)
+        {
+            std::size_t first = m_writes.size();
+            m_first.push_back(first);
+
+            for (std::size_t i{0}; i < m_pins.size() && step.mask >> i; i++)
+            {
+                if (!(step.mask >> i & 1))
+                    continue;
+
+                auto *bank = m_pins[i]->get_bank();
+                auto w = first;
+                while (w < m_writes.size() && m_writes[w].bank != bank)
+                    w++;
+                if (w == m_writes.size())
+                    m_writes.push_back({bank, 0, 0});
+
+                bool high = (step.level >> i & 1) != m_pins[i]->is_active_low();
+                (high ? m_writes[w].set : m_writes[w].clear) |= m_pins[i]->bank_mask();
+            }
+        }
+        m_first.push_back(m_writes.size());
+    }
+
+    template <class Bank>
+    void waveform::write_banks(std::size_t step)
+    {
+        for (auto w = m_first[step]; w < m_first[step + 1]; w++)
+        {
+            const auto &bw = m_writes[w];
+            auto *bank = static_cast<Bank *>(bw.bank);
+            if (bw.set)
+                bank->set(bw.set);
+            if (bw.clear)
+                bank->clear(bw.clear);
+        }
+    }
+
+    int waveform::apply(std::size_t step)
+    {
+        const auto &s = m_steps[step];
+
+        if (m_port)
+            return m_port->set(s.mask, s.level);
+
+        if (!m_first.empty())
+        {
+            if (m_fake_banks)
+                write_banks<bbb::fake_gpio_bank>(step);
+            else
+                write_banks<bbb::gpio_bank>(step);
+            return 0;
+        }
+
+        for (std::size_t i{0}; i < m_pins.size() && s.mask >> i; i++)
+        {
+            if (s.mask >> i & 1 &&
+                m_pins[i]->set_value(s.level >> i & 1 ? bbb::value::high : bbb::value::low) == -1)
+                return -1;
+        }
+        return 0;
+    }
+
+    void waveform::run()
+    {
+        if (rt::set_fifo(m_opt.priority) == -1)
+        {
+            std::cerr << "waveform : SCHED_FIFO cannot be set\n";
+            m_status = -1;
+        }
+        if (m_opt.lock_memory && rt::lock_memory() == -1)
+        {
+            std::cerr << "waveform : memory cannot be locked\n";
+            m_status = -1;
+        }
+
+        uint64_t base = m_base;
+
+        for (uint32_t n{0}; n < m_opt.repeat && !m_stop; n++)
+        {
+            for (std::size_t i{0}; i < m_steps.size() && !m_stop; i++)
+            {
+                uint64_t deadline = base + m_steps[i].time_ns;
+
+                rt::sleep_until(deadline);
+                uint64_t now = rt::now_ns();
+                if (apply(i) == -1)
+                {
+                    std::cerr << "waveform : step " << i << " cannot be written\n";
+                    m_status = -1;
+                    m_stop = true;
+                }
+
+                m_stats.add(now > deadline ? now - deadline : 0);
+            }
+
+            base += m_opt.period_ns;
+        }
+
+        m_running = false;
+    }
+
+    waveform::~waveform()
+    {
+        stop();
+    }
+}
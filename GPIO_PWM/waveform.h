@@ -0,0 +1,98 @@
+/*
+ *  Description : Deterministic waveform player for software bit-banging.
+ *                A precomputed schedule of (time, pin mask, level) steps is
+ *                played from a dedicated thread on absolute deadlines. Bit i
+ *                of a mask refers to the i-th pin given to the constructor.
+ *                Use the mmap backend for the shortest edges, or pins on
+ *                gpio_bank::fake() to run the player in simulation. The
+ *                pins of a step change together : one SET/CLEARDATAOUT
+ *                pair per bank on mmap, one GPIO_V2_LINE_SET_VALUES per
+ *                chip when the pins are given as a chardev gpio_port.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef WAVEFORM_H_
+#define WAVEFORM_H_
+
+#include "gpio.h"
+#include "gpio_port.h"
+#include "rt_thread.h"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+
+namespace bbb
+{
+    struct wave_step
+    {
+        uint64_t time_ns; // from the start of the schedule
+        uint32_t mask;    // pins to change
+        uint32_t level;   // new level of the pins in mask
+    };
+
+    class waveform
+    {
+    public:
+        struct options
+        {
+            int priority{0};         // SCHED_FIFO priority, 0 keeps the default policy
+            bool lock_memory{false}; // mlockall and prefault the stack
+            uint32_t repeat{1};      // number of times the schedule is played
+            uint64_t period_ns{0};   // start-to-start time of repeats, past the last step, needed when repeat > 1
+            uint64_t lead_ns{100'000}; // delay between start() and the first step
+        };
+
+        explicit waveform(std::vector<bbb::gpio *> pins);
+        explicit waveform(bbb::gpio_port &port);
+        waveform(const waveform &) = delete;
+        waveform &operator=(const waveform &) = delete;
+
+        int start(std::vector<bbb::wave_step> steps, const options &opt);
+        int start(std::vector<bbb::wave_step> steps) { return start(std::move(steps), options{}); }
+        int wait();
+        int play(std::vector<bbb::wave_step> steps, const options &opt);
+        void stop();
+
+        bool running() const { return m_running; }
+        uint64_t start_ns() const { return m_base; } // CLOCK_MONOTONIC time of the first play's time 0
+        const bbb::rt::lateness &stats() const { return m_stats; } // valid after wait()
+
+        ~waveform();
+
+    private:
+        struct bank_write
+        {
+            bbb::gpio_bank *bank;
+            uint32_t set;
+            uint32_t clear;
+        };
+
+        void run();
+        void compile();
+        int apply(std::size_t step);
+        template <class Bank>
+        void write_banks(std::size_t step);
+
+        std::vector<bbb::gpio *> m_pins;
+        bbb::gpio_port *m_port{nullptr};
+
+        std::vector<bank_write> m_writes; // mmap : the steps as register writes
+        std::vector<std::size_t> m_first; // mmap : first write of each step, one past the end last
+        bool m_fake_banks{false};         // mmap : the pins are on fake banks
+        std::vector<bbb::wave_step> m_steps;
+        options m_opt;
+
+        std::thread m_thread;
+        std::atomic<bool> m_running{false};
+        std::atomic<bool> m_stop{false};
+        int m_status{0};
+        uint64_t m_base{0};
+
+        bbb::rt::lateness m_stats;
+    };
+}
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ *  Description : Waveform player test. Plays a 1 kHz strobe on two pins and
+ *                prints the lateness of the steps. In simulation the levels
+ *                latched by the fake bank are also checked in the middle of
+ *                every step, across the repeat boundaries.
+ *                usage : waveform_test        (simulation, fake gpio bank)
+ *                        waveform_test hw     (mmap backend, P9_12 / P9_15)
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "waveform.h"
+
+#include <iostream>
+#include <memory>
+#include <cstring>
+#include <thread>
+
+/*
+    3 repeats of 6 ms : both pins high, clk low at 2 ms, strobe low at 4 ms.
+    The idle level of [4, 6) ms must show before the next repeat starts.
+*/
+static int check_levels(const std::shared_ptr<bbb::gpio_bank> &bank, bbb::gpio &clk, bbb::gpio &strobe)
+{
+    const uint64_t ms = 1'000'000;
+    const uint32_t repeats = 3;
+    const uint32_t expected[] = {0b11, 0b10, 0b00}; // strobe, clk in [0, 2), [2, 4), [4, 6)
+
+    bbb::waveform wave{{&clk, &strobe}};
+    bbb::waveform::options opt;
+    opt.repeat = repeats;
+    opt.period_ns = 6 * ms;
+
+    if (wave.start({{0, 0b11, 0b11}, {2 * ms, 0b01, 0b00}, {4 * ms, 0b10, 0b00}}, opt) == -1)
+        return -1;
+
+    const uint32_t clk_bit = clk.bank_mask(), strobe_bit = strobe.bank_mask();
+    int failures{0};
+    for (uint32_t n{0}; n < repeats; n++)
+    {
+        for (uint32_t seg{0}; seg < 3; seg++)
+        {
+            bbb::rt::sleep_until(wave.start_ns() + n * 6 * ms + (2 * seg + 1) * ms);
+
+            uint32_t out = bank->reg(bbb::am335x::gpio_dataout);
+            uint32_t level = (out & clk_bit ? 0b01 : 0) | (out & strobe_bit ? 0b10 : 0);
+            if (level != expected[seg])
+            {
+                std::cerr << "repeat " << n << " at " << 2 * seg + 1 << " ms : levels " << level
+                          << ", expected " << expected[seg] << '\n';
+                failures++;
+            }
+        }
+    }
+
+    return wave.wait() == -1 || failures ? -1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    bool hw = argc > 1 && std::strcmp(argv[1], "hw") == 0;
+
+    std::unique_ptr<bbb::gpio> clk, strobe;
+    if (hw)
+    {
+        clk = std::make_unique<bbb::gpio>(60, bbb::direction::out, bbb::backend::mmap);    // P9_12
+        strobe = std::make_unique<bbb::gpio>(48, bbb::direction::out, bbb::backend::mmap); // P9_15
+    }
+    else
+    {
+        auto bank = bbb::gpio_bank::fake();
+        clk = std::make_unique<bbb::gpio>(60, bbb::direction::out, bank);
+        strobe = std::make_unique<bbb::gpio>(48, bbb::direction::out, bank);
+    }
+
+    /*
+        clk    : 1 kHz square wave, 8 periods
+        strobe : high during the last period
+    */
+    std::vector<bbb::wave_step> steps;
+    for (uint32_t i{0}; i < 16; i++)
+    {
+        uint32_t level = i & 1 ? 0b00 : 0b01;
+        if (i >= 14)
+            level |= 0b10;
+        steps.push_back({i * 500'000ull, 0b11, level});
+    }
+    steps.push_back({16 * 500'000ull, 0b11, 0b00});
+
+    if (!hw)
+    {
+        auto bank = bbb::gpio_bank::fake();
+        bbb::gpio a{60, bbb::direction::out, bank}, b{48, bbb::direction::out, bank};
+
+        bool ok = check_levels(bank, a, b) == 0;
+        std::cout << "levels : " << (ok ? "passed" : "FAILED") << '\n';
+        if (!ok)
+            return 1;
+    }
+
+    bbb::waveform wave{{clk.get(), strobe.get()}};
+
+    bbb::waveform::options opt;
+    opt.repeat = 100;
+    opt.period_ns = 8'500'000; // 0.5 ms idle between bursts
+    opt.priority = hw ? 80 : 0;
+    opt.lock_memory = hw;
+
+    if (wave.play(steps, opt) == -1)
+    {
+        std::cerr << "waveform cannot be played\n";
+        return 1;
+    }
+
+    auto &st = wave.stats();
+    std::cout << "steps : " << st.count << '\n'
+              << "late  : min " << st.min_ns / 1000. << " us, mean "
+              << st.mean_ns() / 1000. << " us, max " << st.max_ns / 1000. << " us\n";
+
+    for (int i{0}; i < bbb::rt::lateness::buckets; i++)
+    {
+        if (st.histogram[i])
+            std::cout << "  < " << (2u << i) << " us : " << st.histogram[i] << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ *  Description : Per-device bus instrumentation. Every transaction of an
+ *                i2c_device or spi_device is counted with relaxed atomics,
+ *                no lock on the transfer path : transactions, bytes in and
+ *                out, errors, retries, time on the bus and a latency
+ *                histogram per transaction type. snapshot() copies them
+ *                out and bus_counter_dump prints registered devices
+ *                periodically.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "bus_counters.h"
+
+namespace bbb
+{
+    constexpr static const std::memory_order relaxed = std::memory_order_relaxed;
+
+    void bus_counters::record(bbb::xfer_type t, uint64_t in, uint64_t out, uint64_t bus_ns, uint64_t latency_ns, bool ok)
+    {
+        auto &c = m_type[static_cast<int>(t)];
+
+        c.transactions.fetch_add(1, relaxed);
+        if (!ok)
+            c.errors.fetch_add(1, relaxed);
+        c.bus_ns.fetch_add(bus_ns, relaxed);
+
+        uint64_t max = c.max_ns.load(relaxed);
+        while (latency_ns > max && !c.max_ns.compare_exchange_weak(max, latency_ns, relaxed))
+            ;
+
+        int i{0};
+        for (uint64_t us = latency_ns / 1000; us > 1 && i < buckets - 1; us >>= 1)
+            i++;
+        c.histogram[i].fetch_add(1, relaxed);
+
+        m_bytes_in.fetch_add(in, relaxed);
+        m_bytes_out.fetch_add(out, relaxed);
+    }
+
+    /* Each counter is read atomically, the snapshot as a whole is not. */
+    bbb::bus_device_stats bus_counters::snapshot() const
+    {
+        bbb::bus_device_stats st;
+
+        for (int t{0}; t < bbb::bus_device_stats::types; t++)
+        {
+            const auto &c = m_type[t];
+            auto &s = st.type[t];
+
+            s.transactions = c.transactions.load(relaxed);
+            s.errors = c.errors.load(relaxed);
+            s.bus_ns = c.bus_ns.load(relaxed);
+            s.max_ns = c.max_ns.load(relaxed);
+            for (int i{0}; i < buckets; i++)
+                s.histogram[i] = c.histogram[i].load(relaxed);
+        }
+
+        st.bytes_in = m_bytes_in.load(relaxed);
+        st.bytes_out = m_bytes_out.load(relaxed);
+        st.retries = m_retries.load(relaxed);
+
+        return st;
+    }
+
+    void bus_counters::clear()
+    {
+        for (auto &c : m_type)
+        {
+            c.transactions.store(0, relaxed);
+            c.errors.store(0, relaxed);
+            c.bus_ns.store(0, relaxed);
+            c.max_ns.store(0, relaxed);
+            for (auto &h : c.histogram)
+                h.store(0, relaxed);
+        }
+
+        m_bytes_in.store(0, relaxed);
+        m_bytes_out.store(0, relaxed);
+        m_retries.store(0, relaxed);
+    }
+
+    std::ostream &operator<<(std::ostream &os, const bbb::bus_device_stats &st)
+    {
+        const char *names[] = {"read ", "write"};
+
+        os << st.transactions() << " transactions, " << st.bytes_in << " bytes in, "
+           << st.bytes_out << " bytes out, " << st.errors() << " errors, " << st.retries
+           << " retries, " << st.bus_ns() / 1000 << " us on the bus\n";
+
+        for (int t{0}; t < bbb::bus_device_stats::types; t++)
+        {
+            const auto &s = st.type[t];
+            if (!s.transactions)
+                continue;
+
+            os << "  " << names[t] << " : " << s.transactions << ", max " << s.max_ns / 1000. << " us, us histogram";
+            for (int i{0}; i < bbb::bus_device_stats::buckets; i++)
+            {
+                if (s.histogram[i])
+                    os << " [" << (i ? 1u << i : 0u) << "] " << s.histogram[i];
+            }
+            os << '\n';
+        }
+
+        return os;
+    }
+
+    void bus_counter_dump::add(std::string name, const bbb::bus_counters &counters)
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+        m_devices.emplace_back(std::move(name), &counters);
+    }
+
+    void bus_counter_dump::print(std::ostream &os)
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+
+        for (const auto &[name, counters] : m_devices)
+            os << name << " : " << counters->snapshot();
+    }
+
+    int bus_counter_dump::start(std::chrono::milliseconds period, std::ostream &os)
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+        if (m_running)
+            return -1;
+
+        m_running = true;
+        m_thread = std::thread{[this, period, &os]
+                               {
+                                   std::unique_lock<std::mutex> lock{m_mtx};
+                                   while (!m_cv.wait_for(lock, period, [this]
+                                                         { return !m_running; }))
+                                   {
+                                       lock.unlock();
+                                       print(os);
+                                       lock.lock();
+                                   }
+                               }};
+
+        return 0;
+    }
+
+    void bus_counter_dump::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mtx};
+            m_running = false;
+        }
+        m_cv.notify_all();
+
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    bus_counter_dump::~bus_counter_dump()
+    {
+        stop();
+    }
+}
@@ -0,0 +1,215 @@
+/*
+ *  Description : Asynchronous bus requests. Every bus (i2c-1, i2c-2, spi0
+ *                ...) gets one worker thread that takes all queued requests
+ *                at once and runs them back to back, so devices on
+ *                different buses proceed in parallel while the caller
+ *                keeps running. A request completes through a future and an
+ *                optional callback, can be cancelled until it starts and is
+ *                dropped if its deadline has passed when its turn comes.
+ *                Buffers passed to a request must stay valid until then.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "bus_worker.h"
+
+#include <map>
+#include <algorithm>
+
+namespace bbb
+{
+    bool async_request::cancel()
+    {
+        if (!m_state)
+            return false;
+
+        int expected = queued;
+        return m_state->compare_exchange_strong(expected, finished);
+    }
+
+    static std::mutex registry_mtx;
+    static std::map<std::string, std::weak_ptr<bus_worker>> registry;
+
+    /* The worker lives while a device holds it. */
+    std::shared_ptr<bus_worker> bus_worker::get(const std::string &bus)
+    {
+        std::lock_guard<std::mutex> lock{registry_mtx};
+
+        auto &slot = registry[bus];
+        auto sp = slot.lock();
+        if (!sp)
+        {
+            sp = std::make_shared<bus_worker>(bus);
+            slot = sp;
+        }
+
+        return sp;
+    }
+
+    bus_worker::bus_worker(std::string name) : m_name{std::move(name)}
+    {
+        m_thread = std::thread{&bus_worker::run, this};
+    }
+
+    bbb::async_request bus_worker::submit(std::function<int()> job, bbb::async_options opts, const void *owner)
+    {
+        bbb::async_request handle;
+        handle.m_state = std::make_shared<std::atomic<int>>(async_request::queued);
+
+        request req{std::move(job), std::move(opts), owner, handle.m_state, {}, clock::now()};
+        handle.result = req.promise.get_future();
+
+        {
+            std::lock_guard<std::mutex> lock{m_mtx};
+            m_queue.push_back(std::move(req));
+        }
+        m_cv.notify_one();
+
+        return handle;
+    }
+
+    /*
+        A device going away takes its requests with it, other devices may keep
+        the worker running. The dropped requests never call back into the
+        device, their futures end with broken_promise. Not waited for when
+        called from a job or callback.
+    */
+    void bus_worker::cancel(const void *owner)
+    {
+        std::unique_lock<std::mutex> lock{m_mtx};
+
+        auto mine = [owner](const request &req)
+        { return req.owner == owner; };
+
+        // the batch is read by the worker, its requests are only flagged
+        for (auto &req : m_batch)
+        {
+            int expected = async_request::queued;
+            if (mine(req) && req.state->compare_exchange_strong(expected, async_request::dropped))
+                m_stats.cancelled++;
+        }
+
+        auto first = std::remove_if(m_queue.begin(), m_queue.end(), mine);
+        m_stats.cancelled += m_queue.end() - first;
+        m_queue.erase(first, m_queue.end());
+
+        if (std::this_thread::get_id() == m_thread.get_id())
+            return;
+
+        m_finished.wait(lock, [this, owner]
+                        { return std::none_of(m_batch.begin(), m_batch.end(), [owner](const request &req)
+                                              { return req.owner == owner && req.state->load() == async_request::running; }); });
+    }
+
+    /* The request stays running until its callback returned.*/
+    void bus_worker::finish(request &req, bbb::async_result res)
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mtx};
+            switch (res.status)
+            {
+            case async_status::done:
+                m_stats.done++;
+                break;
+            case async_status::failed:
+                m_stats.failed++;
+                break;
+            case async_status::cancelled:
+                m_stats.cancelled++;
+                break;
+            case async_status::expired:
+                m_stats.expired++;
+                break;
+            }
+            m_stats.max_queued = std::max(m_stats.max_queued, res.queued);
+            m_stats.max_run = std::max(m_stats.max_run, res.run);
+        }
+
+        if (req.opts.on_done)
+            req.opts.on_done(res);
+        req.promise.set_value(res);
+
+        {
+            std::lock_guard<std::mutex> lock{m_mtx};
+            req.state->store(async_request::finished);
+        }
+        m_finished.notify_all();
+    }
+
+    void bus_worker::run()
+    {
+        std::unique_lock<std::mutex> lock{m_mtx};
+
+        while (true)
+        {
+            m_cv.wait(lock, [this]
+                      { return m_stop || !m_queue.empty(); });
+            if (m_stop)
+                break;
+
+            // the whole queue in one go, new requests wait for the next batch
+            std::move(m_queue.begin(), m_queue.end(), std::back_inserter(m_batch));
+            m_queue.clear();
+            m_stats.batches++;
+            m_stats.max_batch = std::max<uint64_t>(m_stats.max_batch, m_batch.size());
+            lock.unlock();
+
+            for (auto &req : m_batch)
+            {
+                auto start = clock::now();
+                bbb::async_result res{async_status::cancelled, -1, start - req.queued, {}};
+
+                int expected = async_request::queued;
+                if (!req.state->compare_exchange_strong(expected, async_request::running))
+                {
+                    if (expected != async_request::dropped)
+                        finish(req, res);
+                    continue;
+                }
+
+                if (start > req.opts.deadline)
+                {
+                    res.status = async_status::expired;
+                }
+                else
+                {
+                    res.ret = req.job();
+                    res.run = clock::now() - start;
+                    res.status = res.ret == 0 ? async_status::done : async_status::failed;
+                }
+
+                finish(req, res);
+            }
+
+            lock.lock();
+            m_batch.clear();
+        }
+
+        // nothing runs after stop, whatever is left is cancelled
+        auto left = std::move(m_queue);
+        lock.unlock();
+        for (auto &req : left)
+        {
+            finish(req, {async_status::cancelled, -1, clock::now() - req.queued, {}});
+        }
+    }
+
+    bbb::bus_worker_stats bus_worker::stats()
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+        return m_stats;
+    }
+
+    bus_worker::~bus_worker()
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mtx};
+            m_stop = true;
+        }
+        m_cv.notify_one();
+
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ *  Description : A device destroyed with requests still queued on the
+ *                worker of its bus, while another device keeps the worker
+ *                running. None of its callbacks may run afterwards, its
+ *                futures end with broken_promise. Runs on a simulated i2c-3.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "i2cdevice.h"
+#include "i2c_sim.h"
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+static int failures{0};
+
+static void check(const char *what, bool ok)
+{
+    if (!ok)
+    {
+        std::cerr << what << " : failed\n";
+        failures++;
+    }
+}
+
+int main()
+{
+    auto bus = std::make_shared<bbb::i2c_sim_bus>(3, 0);
+    bus->attach(0x20);
+    bus->attach(0x21);
+    bbb::i2c_bus::install(3, bus);
+
+    bbb::i2c_device keeper{3, 0x20};
+    auto *dev = new bbb::i2c_device{3, 0x21};
+
+    std::atomic<bool> destroyed{false};
+    std::atomic<int> late_calls{0};
+    uint8_t buffer[4];
+
+    // the keeper blocks the worker, dev queues behind it in the same batch and in the next one
+    auto slow = keeper.submit([]
+                              { std::this_thread::sleep_for(50ms); return 0; });
+    std::vector<bbb::async_request> reqs;
+    bbb::async_options opts;
+    opts.on_done = [&, dev](const bbb::async_result &)
+    {
+        if (destroyed)
+            late_calls++;
+        else
+            std::cout << "called back by 0x" << std::hex << dev->address() << std::dec << '\n';
+    };
+    reqs.push_back(dev->read_burst_async(0, buffer, sizeof(buffer), opts));
+    std::this_thread::sleep_for(10ms);
+    reqs.push_back(dev->read_burst_async(0, buffer, sizeof(buffer), opts));
+
+    delete dev;
+    destroyed = true;
+
+    check("keeper request", slow.result.get().status == bbb::async_status::done);
+
+    for (auto &r : reqs)
+    {
+        try
+        {
+            r.result.get();
+            check("dropped request completed", false);
+        }
+        catch (const std::future_error &e)
+        {
+            check("broken_promise", e.code() == std::future_errc::broken_promise);
+        }
+    }
+
+    auto after = keeper.read_burst_async(0, buffer, sizeof(buffer));
+    check("worker still running", after.result.get().status == bbb::async_status::done);
+    check("no callback after the device is gone", late_calls == 0);
+
+    std::cout << (failures ? "FAILED" : "passed") << '\n';
+
+    return failures ? 1 : 0;
+}
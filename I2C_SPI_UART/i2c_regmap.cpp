@@ -0,0 +1,234 @@
+/*
+ *  Description : Register shadow cache for an i2c_device. Each register is
+ *                declared cacheable or volatile; cacheable reads are served
+ *                from memory once known, and writes are staged and flushed
+ *                by sync() with consecutive dirty registers coalesced into
+ *                one I2C_RDWR. In write_through mode every write is flushed
+ *                at once, in write_back mode only on sync().
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "i2c_regmap.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <linux/i2c-dev.h>
+
+namespace bbb
+{
+
+    i2c_regmap::i2c_regmap(i2c_device &dev, uint16_t size, bool auto_increment) : m_dev{dev},
+                                                                                   m_regs(size),
+                                                                                   m_auto_increment{auto_increment}
+    {
+        if (size == 0 || size > 256)
+        {
+            throw std::runtime_error{"invalid i2c register map size"};
+        }
+
+        // a message per register at most : the address and one value byte
+        m_frames.resize(2 * size);
+        m_msgs.reserve(2 * size);
+    }
+
+    void i2c_regmap::set_cacheable(uint8_t first, uint8_t last, bool cacheable)
+    {
+        for (uint16_t r{first}; r <= last && r < m_regs.size(); r++)
+        {
+            m_regs[r].cacheable = cacheable;
+            m_regs[r].valid = false;
+        }
+    }
+
+    /* The message limit of an ioctl is even, so an address and its read stay together. */
+    int i2c_regmap::submit()
+    {
+        static_assert(I2C_RDWR_IOCTL_MAX_MSGS % 2 == 0);
+
+        int ret{0};
+
+        for (std::size_t i{0}; i < m_msgs.size() && ret == 0; i += I2C_RDWR_IOCTL_MAX_MSGS)
+        {
+            ret = m_dev.transfer(m_msgs.data() + i, std::min<std::size_t>(m_msgs.size() - i, I2C_RDWR_IOCTL_MAX_MSGS));
+        }
+        m_msgs.clear();
+
+        return ret;
+    }
+
+    int i2c_regmap::read(uint8_t reg, uint8_t &val)
+    {
+        return read(reg, &val, 1);
+    }
+
+    /*
+        Cached registers are copied out, the others are fetched in one
+        transaction : an address write and a read per run of consecutive
+        missing registers, a run being one register without auto increment.
+    */
+    int i2c_regmap::read(uint8_t first, uint8_t *buffer, uint16_t count)
+    {
+        if (first + count > m_regs.size())
+        {
+            std::cerr << "register read out of the i2c register map.\n";
+            return 1;
+        }
+
+        const uint16_t addr = m_dev.address();
+
+        for (uint16_t i{0}; i < count;)
+        {
+            const auto &e = m_regs[first + i];
+            if (e.cacheable && (e.valid || e.dirty))
+            {
+                i++;
+                continue;
+            }
+
+            uint16_t run{1};
+            while (m_auto_increment && i + run < count)
+            {
+                const auto &n = m_regs[first + i + run];
+                if (n.cacheable && (n.valid || n.dirty))
+                    break;
+                run++;
+            }
+
+            m_frames[first + i] = first + i;
+            m_msgs.push_back({addr, 0, 1, &m_frames[first + i]});
+            m_msgs.push_back({addr, I2C_M_RD, run, buffer + i});
+            i += run;
+        }
+
+        if (!m_msgs.empty() && submit() != 0)
+            return 1;
+
+        for (uint16_t i{0}; i < count; i++)
+        {
+            auto &e = m_regs[first + i];
+            if (!e.cacheable)
+                continue;
+
+            if (e.valid || e.dirty)
+            {
+                buffer[i] = e.value;
+            }
+            else
+            {
+                e.value = buffer[i];
+                e.valid = true;
+            }
+        }
+
+        return 0;
+    }
+
+    int i2c_regmap::write(uint8_t reg, uint8_t val)
+    {
+        return write(reg, &val, 1);
+    }
+
+    /* Volatile registers are written at once, cacheable ones are staged. */
+    int i2c_regmap::write(uint8_t first, const uint8_t *values, uint16_t count)
+    {
+        if (first + count > m_regs.size())
+        {
+            std::cerr << "register write out of the i2c register map.\n";
+            return 1;
+        }
+
+        for (uint16_t i{0}; i < count; i++)
+        {
+            auto &e = m_regs[first + i];
+            if (e.cacheable)
+            {
+                e.value = values[i];
+                e.dirty = true;
+            }
+            else if (m_dev.write_register(first + i, values[i]) != 0)
+            {
+                return 1;
+            }
+        }
+
+        return m_mode == mode::write_through ? sync() : 0;
+    }
+
+    int i2c_regmap::update(uint8_t reg, uint8_t mask, uint8_t val)
+    {
+        uint8_t cur;
+        if (read(reg, cur) != 0)
+            return 1;
+
+        uint8_t next = (cur & ~mask) | (val & mask);
+        if (next == cur && m_regs[reg].cacheable)
+            return 0;
+
+        return write(reg, next);
+    }
+
+    /*
+        Flush the dirty registers. With auto increment a run of consecutive
+        dirty registers is one message, otherwise every register is its own
+        message; all of them go out in one I2C_RDWR.
+    */
+    int i2c_regmap::sync()
+    {
+        const uint16_t addr = m_dev.address();
+
+        for (uint16_t r{0}; r < m_regs.size();)
+        {
+            if (!m_regs[r].dirty)
+            {
+                r++;
+                continue;
+            }
+
+            uint16_t run{1};
+            while (m_auto_increment && r + run < m_regs.size() && m_regs[r + run].dirty)
+                run++;
+
+            // frames of a run sit in m_frames[2r .. 2r + run], the address first
+            uint8_t *frame = &m_frames[2 * r];
+            frame[0] = r;
+            for (uint16_t i{0}; i < run; i++)
+                frame[1 + i] = m_regs[r + i].value;
+
+            m_msgs.push_back({addr, 0, static_cast<uint16_t>(run + 1), frame});
+            r += run;
+        }
+
+        if (m_msgs.empty())
+            return 0;
+
+        if (submit() != 0)
+            return 1; // still dirty, sync() can be retried
+
+        for (auto &e : m_regs)
+        {
+            if (e.dirty)
+            {
+                e.dirty = false;
+                e.valid = true;
+            }
+        }
+
+        return 0;
+    }
+
+    /* Forget cached values, staged writes are dropped as well. */
+    void i2c_regmap::invalidate()
+    {
+        for (auto &e : m_regs)
+            e.valid = e.dirty = false;
+    }
+
+    void i2c_regmap::invalidate(uint8_t reg)
+    {
+        if (reg < m_regs.size())
+            m_regs[reg].valid = m_regs[reg].dirty = false;
+    }
+}
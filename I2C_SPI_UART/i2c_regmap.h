@@ -0,0 +1,74 @@
+/*
+ *  Description : Register shadow cache for an i2c_device. Each register is
+ *                declared cacheable or volatile; cacheable reads are served
+ *                from memory once known, and writes are staged and flushed
+ *                by sync() with consecutive dirty registers coalesced into
+ *                one I2C_RDWR. In write_through mode every write is flushed
+ *                at once, in write_back mode only on sync().
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef I2C_REGMAP_H_
+#define I2C_REGMAP_H_
+
+#include "i2cdevice.h"
+
+#include <stdint.h>
+#include <vector>
+#include <linux/i2c.h>
+
+namespace bbb
+{
+
+    class i2c_regmap
+    {
+    public:
+        enum class mode
+        {
+            write_through,
+            write_back
+        };
+
+        // auto_increment : the device advances its register pointer inside a burst
+        i2c_regmap(i2c_device &dev, uint16_t size, bool auto_increment = true);
+        i2c_regmap(const i2c_regmap &) = delete;
+        i2c_regmap &operator=(const i2c_regmap &) = delete;
+
+        void set_cacheable(uint8_t first, uint8_t last, bool cacheable = true); // all volatile by default
+        void set_mode(mode m) { m_mode = m; }
+
+        int read(uint8_t reg, uint8_t &val);
+        int read(uint8_t first, uint8_t *buffer, uint16_t count);
+
+        int write(uint8_t reg, uint8_t val);
+        int write(uint8_t first, const uint8_t *values, uint16_t count);
+        int update(uint8_t reg, uint8_t mask, uint8_t val); // no bus access if the bits are already set
+
+        int sync();
+        void invalidate();
+        void invalidate(uint8_t reg);
+
+    private:
+        struct entry
+        {
+            uint8_t value{0};
+            bool cacheable{false};
+            bool valid{false};
+            bool dirty{false};
+        };
+
+        int submit(); // m_msgs in as few I2C_RDWR calls as the kernel accepts
+
+        i2c_device &m_dev;
+        std::vector<entry> m_regs;
+        bool m_auto_increment;
+        mode m_mode{mode::write_through};
+
+        std::vector<uint8_t> m_frames; // message buffers, allocated once
+        std::vector<i2c_msg> m_msgs;
+    };
+}
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ *  Description : One SPI controller shared by its spi_device objects. The
+ *                bus is handed to one device at a time, the most urgent
+ *                waiting priority first and in arrival order within a
+ *                priority. The mode, speed and bits applied to every chip
+ *                select are cached, so SPI_IOC_WR_* is only issued when a
+ *                device needs a different setting than the last user of
+ *                that chip select left.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "spi_bus.h"
+
+#include <iostream>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+
+namespace bbb
+{
+    static std::mutex registry_mtx;
+    static std::map<uint16_t, std::weak_ptr<spi_bus>> registry;
+
+    std::shared_ptr<spi_bus> spi_bus::get(uint16_t bus)
+    {
+        std::lock_guard<std::mutex> lock{registry_mtx};
+
+        auto &slot = registry[bus];
+        auto sp = slot.lock();
+        if (!sp)
+        {
+            sp = std::make_shared<spi_bus>(bus);
+            slot = sp;
+        }
+
+        return sp;
+    }
+
+    /*
+        A waiter gets the bus when it is free, nobody of a higher priority
+        is waiting and every earlier ticket of its own priority was served.
+        A running transfer is never interrupted.
+    */
+    spi_bus::guard spi_bus::acquire(bbb::spi_priority prio)
+    {
+        const int p = static_cast<int>(prio);
+        auto start = std::chrono::steady_clock::now();
+
+        std::unique_lock<std::mutex> lock{m_mtx};
+        uint64_t ticket = m_next[p]++;
+
+        m_cv.wait(lock, [&]
+                  {
+                      if (m_busy || m_serving[p] != ticket)
+                          return false;
+                      for (int q{p + 1}; q < spi_bus_stats::levels; q++)
+                      {
+                          if (m_next[q] != m_serving[q])
+                              return false;
+                      }
+                      return true; });
+
+        m_busy = true;
+        m_serving[p]++;
+
+        m_stats.acquisitions[p]++;
+        auto wait = std::chrono::steady_clock::now() - start;
+        if (wait > m_stats.max_wait[p])
+            m_stats.max_wait[p] = wait;
+
+        return guard{this};
+    }
+
+    void spi_bus::release()
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mtx};
+            m_busy = false;
+        }
+        m_cv.notify_all();
+    }
+
+    static int write_read(int fd, unsigned long wr, unsigned long rd, void *val, const char *what)
+    {
+        if (ioctl(fd, wr, val) == -1 || ioctl(fd, rd, val) == -1)
+        {
+            std::cerr << "SPI : Can't set " << what << ".\n";
+            return -1;
+        }
+        return 0;
+    }
+
+    /* The requested values are cached, a driver rounding the speed does not cause rewrites. */
+    int spi_bus::apply(int fd, uint16_t cs, const bbb::spi_config &cfg)
+    {
+        auto it = m_applied.find(cs);
+        bool known = it != m_applied.end();
+
+        uint64_t writes{0};
+        int ret{0};
+
+        if (!known || it->second.mode != cfg.mode)
+        {
+            uint8_t mode = cfg.mode;
+            ret |= write_read(fd, SPI_IOC_WR_MODE, SPI_IOC_RD_MODE, &mode, "SPI mode");
+            writes++;
+        }
+        if (!known || it->second.speed != cfg.speed)
+        {
+            uint32_t speed = cfg.speed;
+            ret |= write_read(fd, SPI_IOC_WR_MAX_SPEED_HZ, SPI_IOC_RD_MAX_SPEED_HZ, &speed, "max speed HZ");
+            writes++;
+        }
+        if (!known || it->second.bits != cfg.bits)
+        {
+            uint8_t bits = cfg.bits;
+            ret |= write_read(fd, SPI_IOC_WR_BITS_PER_WORD, SPI_IOC_RD_BITS_PER_WORD, &bits, "bits per word");
+            writes++;
+        }
+
+        if (ret)
+            m_applied.erase(cs);
+        else
+            m_applied[cs] = cfg;
+
+        std::lock_guard<std::mutex> lock{m_mtx};
+        m_stats.config_writes += writes;
+        if (!writes)
+            m_stats.config_skipped++;
+
+        return ret ? -1 : 0;
+    }
+
+    void spi_bus::forget(uint16_t cs)
+    {
+        m_applied.erase(cs);
+    }
+
+    bbb::spi_bus_stats spi_bus::stats()
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+        return m_stats;
+    }
+}
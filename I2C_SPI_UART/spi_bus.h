@@ -0,0 +1,101 @@
+/*
+ *  Description : One SPI controller shared by its spi_device objects. The
+ *                bus is handed to one device at a time, the most urgent
+ *                waiting priority first and in arrival order within a
+ *                priority. The mode, speed and bits applied to every chip
+ *                select are cached, so SPI_IOC_WR_* is only issued when a
+ *                device needs a different setting than the last user of
+ *                that chip select left.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef SPI_BUS_H_
+#define SPI_BUS_H_
+
+#include <stdint.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+
+namespace bbb
+{
+    enum class spi_priority : uint8_t
+    {
+        bulk,    // streams, display frames, flash logging
+        normal,
+        realtime // sensors read from a control loop
+    };
+
+    struct spi_config
+    {
+        uint8_t mode;
+        uint32_t speed;
+        uint8_t bits;
+    };
+
+    struct spi_bus_stats
+    {
+        constexpr static const int levels = 3;
+
+        uint64_t acquisitions[levels]{0};
+        std::chrono::nanoseconds max_wait[levels]{};
+        uint64_t config_writes{0};  // SPI_IOC_WR_* issued
+        uint64_t config_skipped{0}; // settings already applied
+    };
+
+    class spi_bus
+    {
+    public:
+        class guard // holds the bus until destroyed
+        {
+            friend class spi_bus;
+            spi_bus *m_bus;
+            explicit guard(spi_bus *bus) : m_bus{bus} {}
+
+        public:
+            guard(const guard &) = delete;
+            guard &operator=(const guard &) = delete;
+            guard(guard &&other) noexcept : m_bus{other.m_bus} { other.m_bus = nullptr; }
+            ~guard()
+            {
+                if (m_bus)
+                    m_bus->release();
+            }
+        };
+
+        static std::shared_ptr<spi_bus> get(uint16_t bus); // shared by the devices of a controller
+
+        explicit spi_bus(uint16_t bus) : m_number{bus} {}
+        spi_bus(const spi_bus &) = delete;
+        spi_bus &operator=(const spi_bus &) = delete;
+
+        guard acquire(bbb::spi_priority prio);
+
+        // with the bus held, brings the chip select to the config, -1 on error
+        int apply(int fd, uint16_t cs, const bbb::spi_config &cfg);
+        void forget(uint16_t cs); // with the bus held, the chip select state is unknown again
+
+        uint16_t number() const { return m_number; }
+        bbb::spi_bus_stats stats();
+
+    private:
+        void release();
+
+        uint16_t m_number;
+
+        std::mutex m_mtx;
+        std::condition_variable m_cv;
+        bool m_busy{false};
+        uint64_t m_next[spi_bus_stats::levels]{0};    // tickets handed out per priority
+        uint64_t m_serving[spi_bus_stats::levels]{0}; // tickets that got the bus per priority
+
+        std::map<uint16_t, bbb::spi_config> m_applied; // per chip select, only touched with the bus held
+        bbb::spi_bus_stats m_stats;
+    };
+}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ *  Description : Preallocated, aligned buffers for SPI streaming. All
+ *                blocks are allocated once; acquire and release only move
+ *                a pointer between the pool and the caller, so display
+ *                frames or log pages do not allocate per transfer.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "spi_pool.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace bbb
+{
+    spi_buffer::spi_buffer(spi_buffer &&other) noexcept : m_pool{other.m_pool}, m_data{other.m_data}, m_size{other.m_size}
+    {
+        other.m_pool = nullptr;
+        other.m_data = nullptr;
+    }
+
+    spi_buffer &spi_buffer::operator=(spi_buffer &&other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        release();
+        m_pool = other.m_pool;
+        m_data = other.m_data;
+        m_size = other.m_size;
+        other.m_pool = nullptr;
+        other.m_data = nullptr;
+
+        return *this;
+    }
+
+    void spi_buffer::release()
+    {
+        if (m_pool && m_data)
+            m_pool->put(m_data);
+
+        m_pool = nullptr;
+        m_data = nullptr;
+    }
+
+    /* Blocks are rounded up to the alignment so every block starts aligned. */
+    spi_buffer_pool::spi_buffer_pool(std::size_t blocks, std::size_t block_size, std::size_t alignment)
+    {
+        if (blocks == 0 || block_size == 0 || !alignment || (alignment & (alignment - 1)))
+        {
+            throw std::runtime_error{"invalid spi buffer pool"};
+        }
+
+        m_block_size = (block_size + alignment - 1) & ~(alignment - 1);
+        m_memory = static_cast<uint8_t *>(std::aligned_alloc(alignment, blocks * m_block_size));
+        if (!m_memory)
+        {
+            throw std::runtime_error{"spi buffer pool cannot be allocated"};
+        }
+
+        m_free.reserve(blocks);
+        for (std::size_t i{blocks}; i > 0; i--)
+            m_free.push_back(m_memory + (i - 1) * m_block_size);
+    }
+
+    bbb::spi_buffer spi_buffer_pool::acquire()
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+
+        if (m_free.empty())
+            return {};
+
+        uint8_t *block = m_free.back();
+        m_free.pop_back();
+
+        return {this, block, m_block_size};
+    }
+
+    void spi_buffer_pool::put(uint8_t *block)
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+        m_free.push_back(block);
+    }
+
+    std::size_t spi_buffer_pool::available()
+    {
+        std::lock_guard<std::mutex> lock{m_mtx};
+        return m_free.size();
+    }
+
+    spi_buffer_pool::~spi_buffer_pool()
+    {
+        std::free(m_memory);
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ *  Description : Preallocated, aligned buffers for SPI streaming. All
+ *                blocks are allocated once; acquire and release only move
+ *                a pointer between the pool and the caller, so display
+ *                frames or log pages do not allocate per transfer.
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#ifndef SPI_POOL_H_
+#define SPI_POOL_H_
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <mutex>
+
+namespace bbb
+{
+    class spi_buffer_pool;
+
+    class spi_buffer // back to the pool when destroyed
+    {
+        friend class spi_buffer_pool;
+
+        spi_buffer_pool *m_pool{nullptr};
+        uint8_t *m_data{nullptr};
+        std::size_t m_size{0};
+
+        spi_buffer(spi_buffer_pool *pool, uint8_t *data, std::size_t size) : m_pool{pool}, m_data{data}, m_size{size} {}
+
+    public:
+        spi_buffer() = default;
+        spi_buffer(spi_buffer &&other) noexcept;
+        spi_buffer &operator=(spi_buffer &&other) noexcept;
+
+        uint8_t *data() const { return m_data; }
+        std::size_t size() const { return m_size; }
+        explicit operator bool() const { return m_data; }
+
+        void release();
+        ~spi_buffer() { release(); }
+    };
+
+    class spi_buffer_pool
+    {
+    public:
+        spi_buffer_pool(std::size_t blocks, std::size_t block_size, std::size_t alignment = 64);
+        spi_buffer_pool(const spi_buffer_pool &) = delete;
+        spi_buffer_pool &operator=(const spi_buffer_pool &) = delete;
+
+        bbb::spi_buffer acquire(); // empty buffer if the pool is exhausted
+
+        std::size_t block_size() const { return m_block_size; }
+        std::size_t available();
+
+        ~spi_buffer_pool(); // every buffer must be released before
+
+    private:
+        friend class spi_buffer;
+        void put(uint8_t *block);
+
+        std::size_t m_block_size;
+        uint8_t *m_memory{nullptr};
+        std::vector<uint8_t *> m_free; // capacity reserved for every block
+        std::mutex m_mtx;
+    };
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ *  Description : SPI streaming throughput. Frames come from a preallocated
+ *                pool and are streamed in bufsiz messages, the MB/s of
+ *                every frame and the average are printed.
+ *                usage : spi_stream_test [frame bytes] [frames] [speed hz]
+ *                        default : 153600 (320x240 RGB565), 20, 24 MHz
+ *  License     : MIT License
+ *  Created on  : 2026
+ *  Author      : Heval Aktaş
+ *  Email       : hevalakts@gmail.com
+ */
+#include "spidevice.h"
+#include "spi_pool.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char *argv[])
+{
+    std::size_t frame = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 320 * 240 * 2;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 20;
+    uint32_t hz = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 24'000'000;
+
+    bbb::spi_device spi{0, 0};
+    spi.set_speed(hz);
+
+    bbb::spi_buffer_pool pool{2, frame};
+
+    std::cout << "bufsiz : " << bbb::spi_device::bufsiz() << " bytes, "
+              << (frame + bbb::spi_device::bufsiz() - 1) / bbb::spi_device::bufsiz() << " messages per frame\n";
+
+    uint64_t bytes{0}, ns{0};
+    for (int i{0}; i < frames; i++)
+    {
+        auto buf = pool.acquire();
+        std::memset(buf.data(), i, frame);
+
+        if (spi.stream(buf.data(), nullptr, frame) < 0)
+            return 1;
+
+        auto st = spi.last_stream();
+        bytes += st.bytes;
+        ns += st.ns;
+        std::cout << "frame " << i << " : " << st.mb_per_s() << " MB/s\n";
+    }
+
+    std::cout << "average : " << (ns ? bytes * 1e3 / ns : 0.) << " MB/s, line rate "
+              << hz / 8e6 << " MB/s\n";
+
+    return 0;
+}
@@ -12,6 +12,9 @@
 #include <sstream>
 #include <iomanip>
 #include <cstring>
+#include <chrono>
+#include <fstream>
+#include <algorithm>
 
 #include <unistd.h>
 #include <fcntl.h>
@@ -20,7 +23,8 @@
 namespace bbb
 {
 
-    spi_device::spi_device(uint16_t bus, uint16_t dev) : fd{-1}, mode{0}, bits{8}, speed{500'000}, delay{0}
+    spi_device::spi_device(uint16_t bus, uint16_t dev) : fd{-1}, mode{0}, bits{8}, speed{500'000}, delay{0}, bus{bus}, cs{dev},
+                                                         m_bus{spi_bus::get(bus)}
     {
         std::ostringstream oss;
         oss << SPI_PATH << bus << "." << dev;
@@ -29,24 +33,43 @@ namespace bbb
         open();
     }
 
-    spi_device::spi_device(spi_device &&other) : fd{other.fd}, mode{other.mode},
-                                                 bits{other.bits}, speed{other.speed},
-                                                 delay{other.delay},
-                                                 device{std::move(other.device)}
+    spi_device::spi_device(spi_device &&other) : fd{-1}
     {
-        other.fd = -1;
+        *this = std::move(other);
     }
 
+    /*
+        Requests of either device may still be running against its old
+        address, both are drained before any field changes hands.
+    */
     spi_device &spi_device::operator=(spi_device &&other)
     {
         if (this == &other)
             return *this;
 
+        if (m_worker)
+        {
+            m_worker->cancel(this);
+            m_worker.reset();
+        }
+        auto worker = std::move(other.m_worker);
+        if (worker)
+            worker->cancel(&other); // queued jobs hold the old address
+
+        if (fd != -1)
+            close(fd);
+
         mode = other.mode;
         bits = other.bits;
         speed = other.speed;
         delay = other.delay;
         device = std::move(other.device);
+        bus = other.bus;
+        cs = other.cs;
+        m_bus = std::move(other.m_bus);
+        m_priority = other.m_priority;
+        m_worker = std::move(worker);
+        m_format = other.m_format;
 
         fd = other.fd;
         other.fd = -1;
@@ -62,19 +85,27 @@ namespace bbb
             return 1;
         }
 
-        if (set_mode(mode) == -1)
-            return -1;
-        if (set_speed(speed) == -1)
-            return -1;
-        if (set_bits_per_word(bits) == -1)
-            return -1;
+        return configure();
+    }
 
-        return 0;
+    spi_chain &spi_chain::add(const uint8_t *tx, uint8_t *rx, uint32_t length, options opts)
+    {
+        spi_ioc_transfer tr{};
+        tr.tx_buf = reinterpret_cast<uint64_t>(tx);
+        tr.rx_buf = reinterpret_cast<uint64_t>(rx);
+        tr.len = length;
+        tr.speed_hz = opts.speed_hz;
+        tr.delay_usecs = opts.delay_us;
+        tr.bits_per_word = opts.bits;
+        tr.cs_change = opts.cs_change;
+
+        m_segments.push_back(tr);
+        return *this;
     }
 
     int spi_device::transfer(uint8_t tx[], uint8_t rx[], int length)
     {
-        spi_ioc_transfer tr;
+        spi_ioc_transfer tr{};
         tr.tx_buf = reinterpret_cast<uint64_t>(tx);
         tr.rx_buf = reinterpret_cast<uint64_t>(rx);
         tr.len = length;
@@ -83,12 +114,63 @@ namespace bbb
         tr.bits_per_word = bits;
         tr.delay_usecs = delay;
 
-        tr.tx_nbits = 0;
-        tr.rx_nbits = 0;
-        tr.cs_change = 0;
-        tr.pad = 0;
+        return transfer(&tr, 1);
+    }
+
+    int spi_device::transfer(bbb::spi_chain &chain)
+    {
+        return transfer(chain.data(), chain.size());
+    }
+
+    /* A moved-from device has neither a bus nor an fd.*/
+    bool spi_device::is_open() const
+    {
+        if (m_bus && fd >= 0)
+            return true;
+
+        std::cerr << "SPI device is not open.\n";
+        return false;
+    }
+
+    /* Returns the number of bytes transferred by all segments or -1.*/
+    int spi_device::transfer(spi_ioc_transfer *segments, uint32_t count)
+    {
+        if (!is_open())
+            return -1;
+
+        auto queued = std::chrono::steady_clock::now();
+        auto guard = m_bus->acquire(m_priority);
+        if (m_bus->apply(fd, cs, {mode, speed, bits}) == -1)
+            return -1;
+
+        return send(segments, count, queued);
+    }
+
+    int spi_device::send(spi_ioc_transfer *segments, uint32_t count, std::chrono::steady_clock::time_point queued)
+    {
+        if (count == 0 || count > spi_chain::max_segments)
+        {
+            std::cerr << "Invalid number of SPI segments\n";
+            return -1;
+        }
+
+        uint64_t in{0}, out{0};
+        for (uint32_t i{0}; i < count; i++)
+        {
+            if (segments[i].tx_buf)
+                out += segments[i].len;
+            if (segments[i].rx_buf)
+                in += segments[i].len;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        int ret = ioctl(fd, SPI_IOC_MESSAGE(count), segments);
+        auto end = std::chrono::steady_clock::now();
+
+        uint64_t busy = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        uint64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end - queued).count();
+        m_counters.record(in ? xfer_type::read : xfer_type::write, ret >= 0 ? in : 0, out, busy, latency, ret >= 0);
 
-        int ret = ioctl(fd, SPI_IOC_MESSAGE(1), &tr);
         if (ret < 0)
         {
             std::cerr << "Can't send SPI message\n";
@@ -98,6 +180,88 @@ namespace bbb
         return ret;
     }
 
+    /* Read once, the parameter only changes when spidev is loaded again.*/
+    uint32_t spi_device::bufsiz()
+    {
+        static const uint32_t size = []
+        {
+            std::ifstream file{"/sys/module/spidev/parameters/bufsiz"};
+            uint32_t val{0};
+            return file >> val && val ? val : 4096u; // spidev default
+        }();
+
+        return size;
+    }
+
+    /*
+        spidev rejects a message longer than bufsiz in total, so a long
+        buffer cannot be one chained message. It goes out as consecutive
+        bufsiz messages instead, each pointing into the caller's buffers,
+        and cs_change on all but the last keeps the chip selected between
+        them, so the device sees one continuous transfer.
+    */
+    int spi_device::stream(const uint8_t *tx, uint8_t *rx, std::size_t length)
+    {
+        const uint32_t chunk = bufsiz();
+
+        if (!is_open())
+            return -1;
+
+        // the whole stream holds the bus, chip select stays asserted in between
+        auto queued = std::chrono::steady_clock::now();
+        auto guard = m_bus->acquire(m_priority);
+        m_stream = {};
+        if (m_bus->apply(fd, cs, {mode, speed, bits}) == -1)
+            return -1;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t offset{0}; offset < length;)
+        {
+            uint32_t len = std::min<std::size_t>(length - offset, chunk);
+
+            spi_ioc_transfer tr{};
+            tr.tx_buf = tx ? reinterpret_cast<uint64_t>(tx + offset) : 0;
+            tr.rx_buf = rx ? reinterpret_cast<uint64_t>(rx + offset) : 0;
+            tr.len = len;
+            tr.speed_hz = speed;
+            tr.bits_per_word = bits;
+            tr.delay_usecs = delay;
+            tr.cs_change = offset + len < length;
+
+            // the first message carries the wait for the bus
+            if (send(&tr, 1, offset ? std::chrono::steady_clock::now() : queued) < 0)
+                return -1;
+
+            offset += len;
+            m_stream.bytes += len;
+            m_stream.messages++;
+        }
+
+        m_stream.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        return m_stream.bytes;
+    }
+
+    /* Devices of one controller (spidev0.0, spidev0.1) share a worker.*/
+    bbb::async_request spi_device::submit(std::function<int()> job, bbb::async_options opts)
+    {
+        auto worker = std::atomic_load(&m_worker);
+        if (!worker)
+        {
+            worker = bus_worker::get("spi" + std::to_string(bus));
+            std::atomic_store(&m_worker, worker);
+        }
+        return worker->submit(std::move(job), std::move(opts), this);
+    }
+
+    bbb::async_request spi_device::transfer_async(uint8_t tx[], uint8_t rx[], int length, bbb::async_options opts)
+    {
+        return submit([this, tx, rx, length]
+                      { return transfer(tx, rx, length) < 0 ? -1 : 0; },
+                      std::move(opts));
+    }
+
     void spi_device::spi_test(uint8_t rx[], size_t length)
     {
 
@@ -126,14 +290,9 @@ namespace bbb
 
     uint8_t spi_device::read_reg(uint8_t regaddr)
     {
-        uint8_t tx_buf[2];
-        uint8_t rx_buf[2];
-        tx_buf[0] = 0x80 | regaddr;
-        tx_buf[1] = 0;
-        memset(rx_buf, 0, sizeof(rx_buf));
-
-        transfer(tx_buf, rx_buf, 2);
-        return rx_buf[1];
+        uint8_t val{0};
+        read_regs(regaddr, &val, 1);
+        return val;
     }
 
     int spi_device::write(uint8_t value)
@@ -144,72 +303,109 @@ namespace bbb
 
     int spi_device::write(uint8_t value[], int lenght)
     {
+        if (static_cast<uint32_t>(lenght) > bufsiz())
+            return stream(value, nullptr, lenght) < 0 ? -1 : 0;
+
         transfer(value, nullptr, lenght);
         return 0;
     }
 
     int spi_device::write_reg(uint8_t regaddr, uint8_t value)
     {
-        uint8_t tx_buf[2] = {regaddr, value};
-        uint8_t rx_buf[2];
-        memset(rx_buf, 0, sizeof(rx_buf));
-
-        transfer(tx_buf, rx_buf, 2);
+        write_regs(regaddr, &value, 1);
         return 0;
     }
 
-    int spi_device::set_speed(uint32_t hz)
+    int spi_device::read_regs(uint8_t start, uint8_t *buffer, uint16_t count)
     {
-        speed = hz;
+        return access_regs(start, buffer, nullptr, count);
+    }
 
-        if (ioctl(fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed) == -1)
-        {
-            std::cerr << "SPI : Can't set max speed HZ";
+    int spi_device::write_regs(uint8_t start, const uint8_t *buffer, uint16_t count)
+    {
+        return access_regs(start, nullptr, buffer, count);
+    }
+
+    /*
+        The address byte and the data are two segments under one chip select,
+        so the data moves to or from the caller's buffer without a copy.
+        Without auto increment every register gets its own address and data
+        segments, chip select toggling between registers. A message holds at
+        most bufsiz bytes and max_segments segments, a longer access is split
+        into several messages each addressing its first register. The chain
+        is built with the bus held, which also serializes the threads of this
+        device.
+    */
+    int spi_device::access_regs(uint8_t start, uint8_t *rx, const uint8_t *tx, uint16_t count)
+    {
+        if (count == 0)
+            return 0;
+        if (!is_open())
             return -1;
-        }
-        if (ioctl(fd, SPI_IOC_RD_MAX_SPEED_HZ, &speed) == -1)
-        {
-            std::cerr << "SPI : Can't get max speed HZ.";
+
+        auto queued = std::chrono::steady_clock::now();
+        auto guard = m_bus->acquire(m_priority);
+        if (m_bus->apply(fd, cs, {mode, speed, bits}) == -1)
             return -1;
+
+        const uint8_t flag = rx ? m_format.read_flag : m_format.write_flag;
+        const uint32_t per_message = m_format.auto_increment ? bufsiz() - 1
+                                                             : std::min(spi_chain::max_segments / 2, bufsiz() / 2);
+
+        for (uint32_t done{0}; done < count;)
+        {
+            const uint32_t regs = std::min<uint32_t>(count - done, per_message);
+            const uint32_t addresses = m_format.auto_increment ? 1 : regs;
+            const uint32_t len = m_format.auto_increment ? regs : 1;
+
+            if (m_cmds.size() < addresses)
+                m_cmds.resize(addresses);
+
+            m_regs.clear();
+            for (uint32_t i{0}; i < addresses; i++)
+            {
+                const uint32_t reg = done + i;
+
+                m_cmds[i] = (start + reg) | flag | (len > 1 ? m_format.increment_flag : 0);
+                m_regs.add(&m_cmds[i], nullptr, 1, {speed, 0, false, bits});
+                m_regs.add(tx ? tx + reg : nullptr, rx ? rx + reg : nullptr, len, {speed, delay, i + 1 < addresses, bits});
+            }
+
+            if (send(m_regs.data(), m_regs.size(), done ? std::chrono::steady_clock::now() : queued) < 0)
+                return -1;
+
+            done += regs;
         }
 
         return 0;
     }
 
-    int spi_device::set_mode(uint8_t m)
+    /* The setting reaches the driver through the bus, only if the chip select is not set up like that already.*/
+    int spi_device::configure()
     {
-        mode = m;
-
-        if (ioctl(fd, SPI_IOC_WR_MODE, &mode) == -1)
-        {
-            std::cerr << "SPI : Can't set SPI mode.";
-            return -1;
-        }
-        if (ioctl(fd, SPI_IOC_RD_MODE, &mode) == -1)
-        {
-            std::cerr << "SPI : Can't get SPI mode.";
+        if (!is_open())
             return -1;
-        }
 
-        return 0;
+        auto guard = m_bus->acquire(m_priority);
+        return m_bus->apply(fd, cs, {mode, speed, bits});
     }
 
-    int spi_device::set_bits_per_word(uint8_t bit)
+    int spi_device::set_speed(uint32_t hz)
     {
-        bits = bit;
+        speed = hz;
+        return configure();
+    }
 
-        if (ioctl(fd, SPI_IOC_WR_BITS_PER_WORD, &bits) == -1)
-        {
-            std::cerr << "SPI : Can't set bits per word.";
-            return -1;
-        }
-        if (ioctl(fd, SPI_IOC_RD_BITS_PER_WORD, &bits) == -1)
-        {
-            std::cerr << "SPI : Can't get bits per word.";
-            return -1;
-        }
+    int spi_device::set_mode(uint8_t m)
+    {
+        mode = m;
+        return configure();
+    }
 
-        return 0;
+    int spi_device::set_bits_per_word(uint8_t bit)
+    {
+        bits = bit;
+        return configure();
     }
 
     void spi_device::close(int fd)
@@ -220,6 +416,10 @@ namespace bbb
 
     spi_device::~spi_device()
     {
+        if (m_worker)
+            m_worker->cancel(this); // other devices may keep the worker, none of our jobs may run after this
+        m_worker.reset();
+
         if (fd != -1)
         {
             close(fd);
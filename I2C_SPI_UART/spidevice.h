@@ -11,12 +11,66 @@
 
 #include <string>
 #include <stdint.h>
+#include <memory>
+#include <vector>
 #include <linux/spi/spidev.h>
+#include "bus_worker.h"
+#include "bus_counters.h"
+#include "spi_bus.h"
+#include <chrono>
 
 #define SPI_PATH "/dev/spidev"
 
 namespace bbb
 {
+    /*
+        Segments of one SPI message, sent with a single SPI_IOC_MESSAGE(N).
+        Chip select stays asserted across segments unless a segment sets
+        cs_change, which toggles it after that segment (after the last one
+        it keeps chip select asserted for the next message instead).
+        spidev limits the bytes of one message to its bufsiz parameter.
+        The buffers must stay valid until the transfer returns.
+    */
+    class spi_chain
+    {
+    public:
+        struct options
+        {
+            uint32_t speed_hz{0}; // 0 -> speed of the device
+            uint16_t delay_us{0}; // after the segment, before cs_change
+            bool cs_change{false};
+            uint8_t bits{0};      // 0 -> bits per word of the device
+        };
+
+        constexpr static const uint32_t max_segments = (1u << _IOC_SIZEBITS) / sizeof(spi_ioc_transfer) - 1;
+
+        spi_chain &add(const uint8_t *tx, uint8_t *rx, uint32_t length, options opts);
+        spi_chain &add(const uint8_t *tx, uint8_t *rx, uint32_t length) { return add(tx, rx, length, options{}); }
+        void clear() { m_segments.clear(); }
+
+        std::size_t size() const { return m_segments.size(); }
+        spi_ioc_transfer *data() { return m_segments.data(); }
+
+    private:
+        std::vector<spi_ioc_transfer> m_segments;
+    };
+
+    struct spi_stream_stats
+    {
+        uint64_t bytes{0};
+        uint32_t messages{0};
+        uint64_t ns{0};
+
+        double mb_per_s() const { return ns ? bytes * 1e3 / ns : 0.; }
+    };
+
+    struct spi_reg_format // how a register address is sent
+    {
+        uint8_t read_flag{0x80};      // or-ed into the address of a read
+        uint8_t write_flag{0x00};     // or-ed into the address of a write
+        uint8_t increment_flag{0x00}; // or-ed into the address of a multi-byte access, 0x40 on many sensors
+        bool auto_increment{true};    // false : every register is addressed on its own
+    };
 
     class spi_device
     {
@@ -30,13 +84,35 @@ namespace bbb
         int set_bits_per_word(uint8_t bits);
         int set_speed(uint32_t speed);
 
+        void set_priority(bbb::spi_priority prio) { m_priority = prio; } // for the shared bus
+        std::shared_ptr<bbb::spi_bus> get_bus() const { return m_bus; }
+
         int transfer(uint8_t tx[], uint8_t rx[], int length);
+        int transfer(bbb::spi_chain &chain); // all segments in one ioctl
+        int transfer(spi_ioc_transfer *segments, uint32_t count);
+
+        // any length, split into bufsiz messages with chip select held in between, no copies
+        int stream(const uint8_t *tx, uint8_t *rx, std::size_t length);
+        bbb::spi_stream_stats last_stream() const { return m_stream; }
+        static uint32_t bufsiz(); // spidev limit of one message
+
+        // run on the worker of the controller, the buffers and the device must outlive the request
+        bbb::async_request transfer_async(uint8_t tx[], uint8_t rx[], int length, bbb::async_options opts = {});
+        bbb::async_request submit(std::function<int()> job, bbb::async_options opts = {});
+
+        const bbb::bus_counters &counters() const { return m_counters; }
+        bbb::bus_device_stats stats() const { return m_counters.snapshot(); }
 
         uint8_t read_reg(uint8_t regaddr);
         int write(uint8_t value);
         int write(uint8_t value[], int lenght);
         int write_reg(uint8_t regaddr, uint8_t value);
 
+        // count registers from start straight into or from the buffer, one ioctl unless over the spidev limits
+        void set_reg_format(const bbb::spi_reg_format &format) { m_format = format; }
+        int read_regs(uint8_t start, uint8_t *buffer, uint16_t count);
+        int write_regs(uint8_t start, const uint8_t *buffer, uint16_t count);
+
         void spi_test(uint8_t rx[], size_t length);
         int get_lsb();
 
@@ -53,6 +129,25 @@ namespace bbb
 
         int fd;
         std::string device;
+
+        uint16_t bus;
+        uint16_t cs;
+        std::shared_ptr<bbb::spi_bus> m_bus; // serializes the devices of the controller
+        bbb::spi_priority m_priority{bbb::spi_priority::normal};
+        std::shared_ptr<bbb::bus_worker> m_worker; // started by the first async request
+
+        bbb::bus_counters m_counters; // not moved with the device
+        bbb::spi_stream_stats m_stream;
+
+        bbb::spi_reg_format m_format;
+        bbb::spi_chain m_regs;       // reused with the bus held, grows to the largest access once
+        std::vector<uint8_t> m_cmds; // register addresses without auto increment
+
+        int access_regs(uint8_t start, uint8_t *rx, const uint8_t *tx, uint16_t count);
+        int configure();
+        bool is_open() const;
+        // with the bus held, the latency counts from queued, the wait for the bus included
+        int send(spi_ioc_transfer *segments, uint32_t count, std::chrono::steady_clock::time_point queued);
     };
 }
 